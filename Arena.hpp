@@ -0,0 +1,85 @@
+#ifndef _ARENA_HPP
+#define _ARENA_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "util.hpp"
+
+// Bump allocator for everything that lives as long as the simulation (PCBs), all freed at once when it goes
+// - Memory is carved out of big blocks in order, so objects created one after another sit next to each other
+// - Nothing is freed on its own, anything too big for a block gets a block of its own
+// - Objects made with Create() are destroyed when the arena is, in the order they were created
+class Arena {
+public:
+	NON_COPYABLE(Arena)
+
+	static constexpr std::size_t BlockSize = 1 << 20;
+
+	Arena() = default;
+
+	~Arena()
+	{
+		for (const Destructor& destructor : mDestructors) {
+			destructor.mDestroy(destructor.mObject);
+		}
+	}
+
+	void* Allocate(std::size_t size, std::size_t alignment)
+	{
+		std::uintptr_t start = (reinterpret_cast<std::uintptr_t>(mCursor) + alignment - 1) & ~(alignment - 1);
+		if (!mCursor || start + size > reinterpret_cast<std::uintptr_t>(mEnd)) {
+			NewBlock(size + alignment);
+			start = (reinterpret_cast<std::uintptr_t>(mCursor) + alignment - 1) & ~(alignment - 1);
+		}
+
+		mCursor = reinterpret_cast<std::byte*>(start + size);
+		mBytesUsed += size;
+		return reinterpret_cast<void*>(start);
+	}
+
+	template <typename T, typename... Args>
+	T* Create(Args&&... args)
+	{
+		T* object = new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			mDestructors.push_back({ object, [](void* pointer) { static_cast<T*>(pointer)->~T(); } });
+		}
+
+		return object;
+	}
+
+	inline std::size_t GetBytesUsed() const { return mBytesUsed; }
+	inline std::size_t GetBytesReserved() const { return mBytesReserved; }
+
+private:
+	struct Destructor {
+		void* mObject;
+		void (*mDestroy)(void*);
+	};
+
+	void NewBlock(std::size_t minimum)
+	{
+		const std::size_t size = std::max(BlockSize, minimum);
+		mBlocks.push_back(std::make_unique_for_overwrite<std::byte[]>(size));
+		mCursor = mBlocks.back().get();
+		mEnd    = mCursor + size;
+		mBytesReserved += size;
+	}
+
+	std::vector<std::unique_ptr<std::byte[]>> mBlocks;
+	std::byte* mCursor = nullptr; // Next free byte of the newest block
+	std::byte* mEnd    = nullptr;
+
+	std::vector<Destructor> mDestructors;
+	std::size_t mBytesUsed     = 0;
+	std::size_t mBytesReserved = 0;
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <iostream>
+#include <iomanip>
 #include <vector>
 
 #include "IScheduler.hpp"
@@ -7,18 +8,64 @@
 #include "util.hpp"
 #include "CPU.hpp"
 #include "rng.hpp"
+#include "algo/FCFSScheduler.hpp"
+#include "algo/SJFScheduler.hpp"
+#include "algo/SRTFScheduler.hpp"
+#include "algo/RRScheduler.hpp"
+#include "algo/PriorityScheduler.hpp"
+#include "algo/MLFQScheduler.hpp"
+#include "algo/FairScheduler.hpp"
+#include "algo/EDFScheduler.hpp"
+#include "algo/GroupScheduler.hpp"
+
+bool CPU::Screen(ProcessControlBlock* other)
+{
+	SleepForTime(cfg::gProcessCreationCost);
+	mCreatedCount++;
+
+	// Anything already waiting for room goes first
+	if (!mDeferred.empty()) {
+		ThreadPrint("[ADMISSION] NEW PROCESS DEFERRED BEHIND [", mDeferred.size(), "] OTHERS");
+		mDeferred.push_back(other);
+		mDeadlineStats.mDeferred++;
+		return false;
+	}
+
+	switch (mScheduler->GetAdmission(other)) {
+	case Admission::Admit:
+		return true;
+	case Admission::Defer:
+		ThreadPrint("[ADMISSION] NEW PROCESS DEFERRED, NOT SCHEDULABLE ALONGSIDE THE OTHERS YET");
+		mDeferred.push_back(other);
+		mDeadlineStats.mDeferred++;
+		return false;
+	case Admission::Reject:
+		ThreadPrint("[ADMISSION] NEW PROCESS REJECTED, NOT SCHEDULABLE ALONGSIDE THE OTHERS");
+		other->mState.store(ProcessState::Terminated);
+		mDeadlineStats.mRejected++;
+		return false;
+	}
+
+	return false;
+}
 
 void CPU::AddProcess(ProcessControlBlock* other)
 {
 	switch (other->mState.load()) {
 	case ProcessState::Created:
-		SleepForTime(cfg::gProcessCreationCost);
-		AssignPID(*other);
-		other->mState.store(ProcessState::Ready);
-		mScheduler->OnNewProcess(other);
+		if (Screen(other)) {
+			Admit(other);
+		}
 		break;
 	case ProcessState::Ready:
-		mScheduler->OnReadyProcess(other);
+		// Preemptive schedulers may want the newcomer on the CPU straight away
+		if (mActiveProcess && mScheduler->ShouldPreempt(mActiveProcess, other)) {
+			ProcessControlBlock* oldActive = mActiveProcess;
+			ContextSwitch(other);
+			Requeue(oldActive);
+		} else {
+			Requeue(other);
+		}
 		break;
 
 	case ProcessState::Running:
@@ -30,90 +77,284 @@ void CPU::AddProcess(ProcessControlBlock* other)
 	}
 }
 
-void CPU::SleepForTime(std::uint64_t timeInMs) { std::this_thread::sleep_for(std::chrono::milliseconds(timeInMs)); }
+void CPU::AddProcessBatch(std::span<ProcessControlBlock* const> batch)
+{
+	mAdmitted.clear();
+	for (ProcessControlBlock* process : batch) {
+		if (process->mState.load() != ProcessState::Created) {
+			PanicMsg("[SCHEDULER] TRY ADD PROCESS BATCH ISN'T NEW (?)");
+			continue;
+		}
+
+		if (!Screen(process)) {
+			continue;
+		}
+
+		// Registered while still new, so the scheduler doesn't queue it yet (admission control still sees it straight away)
+		AssignPID(*process);
+		process->mProcess.ReleaseBurst();
+		mScheduler->OnNewProcess(process);
+		process->mState.store(ProcessState::Ready);
+		mAdmitted.push_back(process);
+	}
 
-void CPU::TerminateProcess(ProcessControlBlock* process)
+	// ... then queued together
+	if (!mAdmitted.empty()) {
+		AddReadyBatch(mAdmitted);
+	}
+}
+
+void CPU::AddReadyBatch(std::span<ProcessControlBlock* const> batch)
 {
-	std::scoped_lock lk(mMutex);
+	mScheduler->OnReadyBatch(batch);
+	for (ProcessControlBlock* pcb : batch) {
+		EnterReady(pcb);
+	}
 
-	mScheduler->OnTerminate(process);
-	if (mScheduler->IsFullProcessListEmpty()) {
-		ThreadPrint("NO PROCESSES REMAIN, EXITING...");
-		mIsActive = false;
+	// A single preemption check for the whole batch, against whoever the scheduler would now pick
+	ProcessControlBlock* candidate = mActiveProcess ? mScheduler->PeekNext() : nullptr;
+	if (candidate && mScheduler->ShouldPreempt(mActiveProcess, candidate)) {
+		ProcessControlBlock* oldActive = mActiveProcess;
+		ContextSwitch(mScheduler->PopNext());
+		Requeue(oldActive);
 	}
+}
+
+void CPU::Admit(ProcessControlBlock* process)
+{
+	AssignPID(*process);
+	process->mState.store(ProcessState::Ready);
 
-	// Just to be sure
-	process->mState.store(ProcessState::Terminated);
-	ThreadPrint("PID[", process->mProcessIdentifier, "] TERMINATED\r\n");
+	// Its deadline only starts counting once it's actually in the system
+	process->mProcess.ReleaseBurst();
+	mScheduler->OnNewProcess(process);
+	EnterReady(process);
 
-	if (mActiveProcess == process) {
-		mActiveProcess = nullptr;
+	// Arriving mid-run, it may well need the CPU more than whatever has it
+	ProcessControlBlock* candidate = mActiveProcess ? mScheduler->PeekNext() : nullptr;
+	if (candidate == process && mScheduler->ShouldPreempt(mActiveProcess, candidate)) {
+		ProcessControlBlock* oldActive = mActiveProcess;
+		ContextSwitch(mScheduler->PopNext());
+		Requeue(oldActive);
 	}
 }
 
-void CPU::AssignPID(ProcessControlBlock& process)
+void CPU::AdmitDeferred()
+{
+	// Strictly in arrival order, so nothing deferred can be starved by smaller processes slipping past it
+	while (!mDeferred.empty() && mScheduler->GetAdmission(mDeferred.front()) == Admission::Admit) {
+		ProcessControlBlock* process = mDeferred.front();
+		mDeferred.pop_front();
+		Admit(process);
+		ThreadPrint("[ADMISSION] PID[", process->mProcessIdentifier, "] ADMITTED AFTER BEING DEFERRED");
+	}
+}
+
+template <typename Policy>
+void CPU::Requeue(ProcessControlBlock* pcb)
 {
-	//! NOTE: No need to worry about race conditions due to program control flow
+	GetPolicyScheduler<Policy>().OnReadyProcess(pcb);
+	EnterReady(pcb);
+}
 
-	// The process ID is the first non-used incremental number starting from 0.
-	// So if [P - 0] [P - 1] [P - 3], the next would be assigned [P - 2].
-	const auto& processList = mScheduler->GetProcessList();
-	std::size_t n           = processList.size();
+void CPU::EnterReady(ProcessControlBlock* pcb)
+{
+	mProcessTable.SetReady(pcb->mProcessIdentifier, pcb->mPriority, pcb->mProcess.GetRemainingPredictedBurstLength(), mTick);
+
+	if (mAlgorithm == SchedulingAlgorithm::Priority) {
+		mAgingQueue.Push(pcb, mAgingTick);
+	}
+}
 
-	// Mark which IDs 0..n are taken
-	std::vector<std::int8_t> used(n + 1, false);
-	for (ProcessControlBlock* pcb : processList) {
-		std::uint32_t id = pcb->mProcessIdentifier;
-		if (id <= n) {
-			used[id] = 1;
+void CPU::LeaveReady(ProcessControlBlock* pcb)
+{
+	mProcessTable.ClearReady(pcb->mProcessIdentifier);
+	mAgingQueue.Remove(pcb);
+}
+
+void CPU::SleepForTime(std::uint64_t timeInMs)
+{
+	// In virtual time the CPU is simply busy for that long, so just move the clock forward
+	if (cfg::gVirtualTime) {
+		mTick += timeInMs;
+		return;
+	}
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(timeInMs));
+}
+
+void CPU::ChargeSchedulerWork()
+{
+	SchedulerWork work;
+	mScheduler->TakeWork(work);
+	mSchedulerWork += work;
+
+	const bool isMeasured = cfg::gSchedulerOverhead == static_cast<std::uint32_t>(SchedulerOverhead::Measured);
+	if (isMeasured) {
+		mOverheadRemainder += work.mNanoseconds;
+	} else {
+		mOverheadRemainder += work.mComparisons * cfg::gSchedulerCompareCost + work.mMoves * cfg::gSchedulerMoveCost +
+		                      work.mLocks * cfg::gSchedulerLockCost;
+	}
+
+	const std::uint64_t tickLength = std::max<std::uint32_t>(cfg::gSchedulerTickLength, 1);
+	const std::uint64_t ticks      = mOverheadRemainder / tickLength;
+	mOverheadRemainder %= tickLength;
+	mOverheadTicks += ticks;
+
+	// Real time has nothing to skip past. Measured, the CPU thread has already spent that long in the scheduler
+	if (!cfg::gVirtualTime) {
+		if (ticks && !isMeasured) {
+			SleepForTime(ticks);
 		}
+
+		return;
 	}
 
-	// Scan for the first hole
-	for (std::size_t i = 0; i <= n; ++i) {
-		if (!used[i]) {
-			process.mProcessIdentifier = static_cast<std::uint16_t>(i);
-			return;
+	// Virtual time pays it off in jumps that stop a tick short of anything due, which the next Step() then handles as usual
+	mOverheadOwed += ticks;
+	if (!mOverheadOwed) {
+		return;
+	}
+
+	std::uint64_t skip = mOverheadOwed;
+	if (DynamicPolicy::HasAging(mAlgorithm)) {
+		const std::uint64_t nextDecay = (mTick / PriorityDecayTicks + 1) * PriorityDecayTicks;
+		skip                          = std::min(skip, nextDecay - mTick - 1);
+	}
+
+	if (mSchedulerPeriod) {
+		skip = std::min(skip, mNextPeriodTick - std::min(mNextPeriodTick, mTick + 1));
+	}
+
+	if (!mEvents.IsEmpty()) {
+		skip = std::min(skip, mEvents.GetNextTime() - std::min(mEvents.GetNextTime(), mTick + 1));
+	}
+
+	mTick += skip;
+	mOverheadOwed -= skip;
+}
+
+void CPU::TerminateProcess(ProcessControlBlock* process) { TerminateBatch(std::span<ProcessControlBlock* const>(&process, 1)); }
+
+void CPU::TerminateBatch(std::span<ProcessControlBlock* const> batch)
+{
+	// Killed while waiting on I/O, make sure it never comes back
+	for (ProcessControlBlock* process : batch) {
+		if (process->mState.load() == ProcessState::Blocked) {
+			mIrqController.CancelIO(process);
 		}
 	}
+
+	mScheduler->OnTerminateBatch(batch);
+	for (ProcessControlBlock* process : batch) {
+		LeaveReady(process);
+		mPids.Release(process->mProcessIdentifier);
+
+		// Just to be sure
+		process->mState.store(ProcessState::Terminated);
+		if (mActiveProcess == process) {
+			mActiveProcess = nullptr;
+		}
+	}
+
+	// Their share of the CPU is free again, which might be enough for whatever admission control held back
+	AdmitDeferred();
+
+	if (mScheduler->IsFullProcessListEmpty()) {
+		ThreadPrint("NO PROCESSES REMAIN, EXITING...");
+		mIsActive = false;
+	}
+
+	for (const ProcessControlBlock* process : batch) {
+		ThreadPrint("PID[", process->mProcessIdentifier, "] TERMINATED\r\n");
+	}
+}
+
+void CPU::AssignPID(ProcessControlBlock& process)
+{
+	//! NOTE: No need to worry about race conditions, only the CPU thread creates processes
+
+	// The process ID is the first non-used incremental number starting from 0.
+	// So if [P - 0] [P - 1] [P - 3], the next would be assigned [P - 2].
+	process.mProcessIdentifier = mPids.Allocate();
 }
 
 void CPU::ContextSwitch(ProcessControlBlock* block)
 {
 	REQUIRE(block != nullptr);
 
-	// Critical section
 	{
-		std::scoped_lock lk(mMutex);
-
 		// It's been swapped with something else
 		if (mActiveProcess) {
 			mActiveProcess->mState.store(ProcessState::Ready);
 
+			// Burst is still in progress, its prediction stands until it actually completes
 			ProcessWork* burst = mActiveProcess->mProcess.GetBurst();
-			if (burst) {
-				if (!burst->IsComplete()) {
-					ThreadPrint("PID[", mActiveProcess->mProcessIdentifier, "] - > SPENT [", burst->mProgress, " ticks] IN WORK");
-				}
-
-				// Burst is still in progress, so update the prediction
-				mActiveProcess->mProcess.UpdatePredictedBurst();
+			if (burst && !burst->IsComplete()) {
+				ThreadPrint("PID[", mActiveProcess->mProcessIdentifier, "] - > SPENT [", burst->mProgress, " ticks] IN WORK");
 			}
 
 			mActiveProcess = nullptr;
 		}
 
-		// Pretend to save data from previous PCB, flush TLS, etc.
-		SleepForTime(cfg::gDispatchLatency);
-
 		mActiveProcess = block;
 		mActiveProcess->mState.store(ProcessState::Running);
 
-		if (mScheduler->GetAlgorithm() == SchedulingAlgorithm::Priority) {
-			mActiveProcess->mInactivePriorityTimer = 0;
-		}
+		// Its aging starts over the next time it's ready
+		LeaveReady(mActiveProcess);
 
 		mQuantumTimer = 0;
+
+		// Pretend to save data from previous PCB, flush TLS, etc. The CPU pays for this in Step()
+		mIsDispatching    = true;
+		mDispatchEndTick  = mTick + cfg::gDispatchLatency;
+		mDispatchDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(cfg::gDispatchLatency);
+	}
+}
+
+void CPU::Unload()
+{
+	REQUIRE(mActiveProcess != nullptr);
+
+	ThreadPrint("PID[", mActiveProcess->mProcessIdentifier, "] UNLOADED, NOTHING IS ALLOWED TO RUN");
+	mActiveProcess->mState.store(ProcessState::Ready);
+	mActiveProcess = nullptr;
+	mQuantumTimer  = 0;
+}
+
+bool CPU::WaitForDispatch()
+{
+	// Virtual time: the CPU is busy for the whole latency, so the clock jumps over it. Interrupts still land on time though
+	if (cfg::gVirtualTime) {
+		if (!mEvents.IsEmpty() && mEvents.GetNextTime() <= mDispatchEndTick) {
+			mTick = std::max(mTick, mEvents.GetNextTime());
+			DeliverEvents();
+			return false;
+		}
+
+		mTick = std::max(mTick, mDispatchEndTick);
+		return true;
+	}
+
+	if (std::chrono::steady_clock::now() >= mDispatchDeadline) {
+		return true;
+	}
+
+	// Sleep until the deadline, an interrupt being posted wakes us early so it can be handled on time
+	std::unique_lock lk(mIdleMutex);
+	mIdleCv.wait_until(lk, mDispatchDeadline, [&] { return mWakePending; });
+	mWakePending = false;
+	return false;
+}
+
+void CPU::FinishDispatch()
+{
+	ProcessControlBlock* active = mActiveProcess;
+	mIsDispatching              = false;
+
+	if (!active) {
+		return;
 	}
 
 	std::stringstream ss;
@@ -121,16 +362,20 @@ void CPU::ContextSwitch(ProcessControlBlock* block)
 	ss << "[D/L - " << cfg::gDispatchLatency << "ms] ";
 
 	// Print the duration of idle CPU time, if we were just idle for X amount of time
-	if (mIsIdle) {
+	if (mIsIdle && cfg::gVirtualTime) {
+		const std::uint64_t difference = mTick - mIdleStartTick;
+		ss << "CPU IDLED FOR [" << difference << "ms (" << difference / 1000 << "s)] [" << active->mProcessIdentifier << "] IS ACTIVE";
+
+		mIsIdle = false;
+	} else if (mIsIdle) {
 		using namespace std::literals;
 		const auto end  = std::chrono::steady_clock::now();
 		auto difference = end - mIdleStartTime;
-		ss << "CPU IDLED FOR [" << difference / 1ms << "ms (" << difference / 1s << "s)] [" << mActiveProcess->mProcessIdentifier
-		   << "] IS ACTIVE";
+		ss << "CPU IDLED FOR [" << difference / 1ms << "ms (" << difference / 1s << "s)] [" << active->mProcessIdentifier << "] IS ACTIVE";
 
 		mIsIdle = false;
 	} else {
-		ss << "[" << mActiveProcess->mProcessIdentifier << "] IS ACTIVE";
+		ss << "[" << active->mProcessIdentifier << "] IS ACTIVE";
 	}
 
 	ThreadPrint(ss.str());
@@ -138,45 +383,201 @@ void CPU::ContextSwitch(ProcessControlBlock* block)
 
 void CPU::Run()
 {
-	const auto processCount = mScheduler->GetProcessList().size();
+	const auto startTime = std::chrono::steady_clock::now();
 
-	// Reset state
-	mTick         = 0;
-	mQuantumTimer = 0;
+	// Reset state, the tick is left alone as virtual process creation has already advanced it
+	mQuantumTimer    = 0;
+	mSchedulerPeriod = mScheduler->GetPeriod();
+	mNextPeriodTick  = mSchedulerPeriod ? (mTick / mSchedulerPeriod + 1) * mSchedulerPeriod : 0;
 
 	mIsIdle   = false;
 	mIsActive = true;
 
 	mActiveProcess = nullptr;
+	mIsDispatching = false;
+	mIrqController.Start();
 
 	// Execution begins!
+	(this->*(mTickLoop ? mTickLoop : GetTickLoop<DynamicPolicy>()))();
+
+	using namespace std::literals;
+	const auto wallTime = std::chrono::steady_clock::now() - startTime;
+	ThreadPrint("CPU TERMINATED EXECUTION [", mTick, "] TICKS (", mStepCount, " STEPS) WITH [", mCreatedCount, "] PROCESSES IN [",
+	            wallTime / 1ms, "ms]\r\n");
+
+	const double utilisation = mTick ? 100.0 * static_cast<double>(mTick - std::min(mIdleTicks, mTick)) / static_cast<double>(mTick) : 0.0;
+	ThreadPrint("CPU IDLED FOR [", mIdleTicks, "] TICKS (", std::fixed, std::setprecision(2), utilisation, "% UTILISATION)\r\n");
+	if (cfg::gSchedulerOverhead) {
+		const double share = mTick ? 100.0 * static_cast<double>(mOverheadTicks) / static_cast<double>(mTick) : 0.0;
+		ThreadPrint("SCHEDULER OVERHEAD [", mOverheadTicks, "] TICKS (", std::fixed, std::setprecision(2), share, "% OF THE RUN) FOR [",
+		            mSchedulerWork.mComparisons, "] COMPARISONS [", mSchedulerWork.mMoves, "] MOVES [", mSchedulerWork.mLocks, "] LOCKS\r\n");
+	}
+
+	mIrqController.PrintStats();
+	mDeadlineStats.Print();
+	mScheduler->PrintStats();
+
+	// Only SJF / SRTF actually schedule by the predictions
+	if (mAlgorithm == SchedulingAlgorithm::SJF || mAlgorithm == SchedulingAlgorithm::SRTF) {
+		mPredictionStats.Print(static_cast<BurstPredictorType>(cfg::gBurstPredictor));
+	}
+}
+
+template <typename Policy>
+CPU::TickLoop CPU::GetTickLoop()
+{
+	return &CPU::RunLoop<Policy>;
+}
+
+template <typename Policy>
+void CPU::RunLoop()
+{
+	// The loop trusts the scheduler to be what it was compiled for, it's cast rather than checked on every call
+	if constexpr (!Policy::IsDynamic) {
+		REQUIRE(mAlgorithm == Policy::Algorithm);
+		REQUIRE(dynamic_cast<typename Policy::Scheduler*>(mScheduler.get()) != nullptr);
+	}
+
 	while (mIsActive) {
-		Step();
+		Step<Policy>();
+
+		// Whatever the scheduler did during the step is paid for before the next one
+		if (cfg::gSchedulerOverhead) {
+			ChargeSchedulerWork();
+		}
 	}
+}
 
-	ThreadPrint("CPU TERMINATED EXECUTION [", mTick, "] TICKS WITH [", processCount, "] PROCESSES\r\n");
+void CPU::Wake()
+{
+	{
+		std::scoped_lock lk(mIdleMutex);
+		mWakePending = true;
+	}
+
+	mIdleCv.notify_one();
 }
 
-void CPU::Step()
+void CPU::WaitForWork()
 {
+	// Virtual time: nothing can change until the next event (or the scheduler's periodic work), so the clock jumps straight there
+	if (cfg::gVirtualTime) {
+		std::uint64_t wakeTick = mEvents.IsEmpty() ? std::numeric_limits<std::uint64_t>::max() : mEvents.GetNextTime();
+		if (mSchedulerPeriod) {
+			wakeTick = std::min(wakeTick, mNextPeriodTick);
+		}
+
+		if (wakeTick != std::numeric_limits<std::uint64_t>::max() && wakeTick > mTick + 1) {
+			const std::uint64_t skip = wakeTick - mTick - 1;
+			mTick += skip;
+			mIdleTicks += skip;
+		}
+
+		return;
+	}
+
+	// Real time: sleep until a process is added, the last one leaves or periodic work is due, counting the wait as idle ticks
+	const auto parkTime = std::chrono::steady_clock::now();
 	{
-		std::scoped_lock lk(mMutex);
-		if (mActiveProcess) {
-			ProcessState state = mActiveProcess->mState.load();
+		std::unique_lock lk(mIdleMutex);
+		const auto wakeUp = [&] { return mWakePending || !mIsActive; };
+		if (mSchedulerPeriod) {
+			mIdleCv.wait_until(lk, parkTime + std::chrono::milliseconds(mNextPeriodTick - std::min(mNextPeriodTick, mTick)), wakeUp);
+		} else {
+			mIdleCv.wait(lk, wakeUp);
+		}
 
-			if (state != ProcessState::Running) {
-				ThreadPrint("PID[", mActiveProcess->mProcessIdentifier, "] STATE CHANGED TO [", StateToString(state),
-				            "] EXTERNALLY -> DROPPING FROM CPU");
-				mActiveProcess = nullptr;
-			}
+		mWakePending = false;
+	}
+
+	using namespace std::literals;
+	const std::uint64_t parkedTicks = static_cast<std::uint64_t>((std::chrono::steady_clock::now() - parkTime) / 1ms);
+	mTick += parkedTicks;
+	mIdleTicks += parkedTicks;
+}
+
+void CPU::DeliverEvents()
+{
+	SimEvent event;
+	while (mEvents.PopDue(mTick, event)) {
+		switch (event.mType) {
+		case SimEvent::Type::IOComplete:
+		case SimEvent::Type::AsyncIOComplete:
+			mIrqController.OnIOExpired(event.mPcb, event.mWhen, event.mDevice, event.mType == SimEvent::Type::AsyncIOComplete);
+			break;
+		case SimEvent::Type::IrqFlush:
+			mIrqController.FlushBatch();
+			break;
+		default:
+			PanicMsg("UNKNOWN SIMULATION EVENT");
+			break;
 		}
 	}
+}
+
+template <typename Policy>
+void CPU::Step()
+{
+	typename Policy::Scheduler& scheduler = GetPolicyScheduler<Policy>();
+
+	// Tick boundary, pick up everything the I/O thread has finished (virtual time uses the event queue instead)
+	if (!cfg::gVirtualTime) {
+		mIrqController.DrainInbox();
+	}
+
+	if (mActiveProcess) {
+		ProcessState state = mActiveProcess->mState.load();
+
+		if (state != ProcessState::Running) {
+			ThreadPrint("PID[", mActiveProcess->mProcessIdentifier, "] STATE CHANGED TO [", StateToString(state),
+			            "] EXTERNALLY -> DROPPING FROM CPU");
+			mActiveProcess = nullptr;
+		}
+	}
+
+	// Still loading the next process, no work happens until that's done
+	if (mIsDispatching) {
+		if (WaitForDispatch()) {
+			FinishDispatch();
+		}
+
+		return;
+	}
+
+	// Jump over the ticks where nothing interesting can happen, the tick after that is done as usual
+	if (cfg::gVirtualTime && cfg::gFastForward) {
+		FastForward<Policy>();
+	}
 
 	mTick++;
+	mStepCount++;
+
+	// Fire anything that has come due in virtual time (the I/O thread does this in real time)
+	if (cfg::gVirtualTime) {
+		DeliverEvents();
+	}
 
 	// Handle priority bumping after ... time
-	if (mScheduler->GetAlgorithm() == SchedulingAlgorithm::Priority) {
-		HandlePriorityAging();
+	if (Policy::HasAging(mAlgorithm)) {
+		mAgingTick++;
+		HandlePriorityAging<Policy>();
+	}
+
+	// Periodic scheduler work (e.g. the MLFQ priority boost)
+	if (Policy::HasPeriod(mAlgorithm) && mSchedulerPeriod && mTick >= mNextPeriodTick) {
+		const std::uint64_t oldQuantum = (Policy::HasQuantum(mAlgorithm) && mActiveProcess) ? scheduler.GetTimeQuantum(mActiveProcess) : 0;
+		scheduler.OnPeriodic();
+
+		// A boost can shrink the running process's quantum, it starts the new one afresh rather than expiring on the old count
+		if (oldQuantum && scheduler.GetTimeQuantum(mActiveProcess) < oldQuantum) {
+			mQuantumTimer = 0;
+		}
+		mNextPeriodTick = (mTick / mSchedulerPeriod + 1) * mSchedulerPeriod;
+	}
+
+	// An interrupt or aging preempted the active process, the new one can't run until it has been dispatched
+	if (mIsDispatching) {
+		return;
 	}
 
 	if (mActiveProcess) {
@@ -193,10 +594,38 @@ void CPU::Step()
 			return;
 		}
 
+		// [If async I/O] Hand it to the device and keep going, the process only blocks at its wait point
+		if (burst->mType == ProcessWork::Type::IO && burst->mIsAsync) {
+			ThreadPrint("PID[", mActiveProcess->mProcessIdentifier, "] - > [SUBMITTED ASYNC I/O FOR ", burst->mDuration, "ms]");
+			mIrqController.SubmitAsync(mActiveProcess);
+			proc.PopCurrentBurst();
+			return;
+		}
+
+		// [If waiting] Block until the outstanding async I/O is done, unless it already is
+		if (burst->mType == ProcessWork::Type::Wait) {
+			if (!mIrqController.WaitForAsync(mActiveProcess)) {
+				ThreadPrint("PID[", mActiveProcess->mProcessIdentifier, "] - > [BLOCKED WAITING ON ",
+				            mIrqController.GetOutstandingIO(mActiveProcess), " ASYNC I/O]");
+				mActiveProcess->mState.store(ProcessState::Blocked);
+				scheduler.OnBlocked(mActiveProcess);
+				mActiveProcess = nullptr;
+				return;
+			}
+
+			proc.PopCurrentBurst();
+			if (!proc.GetBurst()) {
+				TerminateProcess(mActiveProcess);
+			}
+
+			return;
+		}
+
 		// [If I/O] Block immediately; IOWorker will resume it later
 		if (burst->mType == ProcessWork::Type::IO) {
 			ThreadPrint("PID[", mActiveProcess->mProcessIdentifier, "] - > [BLOCKED I/O FOR ", burst->mDuration, "ms]");
 			mActiveProcess->mState.store(ProcessState::Blocked);
+			scheduler.OnBlocked(mActiveProcess);
 			mIrqController.NotifyBlocked(mActiveProcess);
 			mActiveProcess = nullptr;
 			return;
@@ -213,113 +642,230 @@ void CPU::Step()
 			return;
 		}
 
-		const SchedulingAlgorithm algo = mScheduler->GetAlgorithm();
+		if (Policy::HasRunningHooks(mAlgorithm)) {
+			scheduler.OnRunning(mActiveProcess, 1);
+		}
 
 		// Handle decay every 1500 ticks
-		if (algo == SchedulingAlgorithm::Priority) {
-			if (mTick % 1500 == 0 && mActiveProcess->mPriority > mActiveProcess->mBasePriority) {
+		if (Policy::HasAging(mAlgorithm)) {
+			if (mTick % PriorityDecayTicks == 0 && mActiveProcess->mPriority > mActiveProcess->mBasePriority) {
 				mActiveProcess->mPriority--;
 				ThreadPrint("[PRIO] PID[", mActiveProcess->mProcessIdentifier, "] DECAYED TO [", mActiveProcess->mPriority, "]");
-				CheckPriorityPreempts();
+				CheckPriorityPreempts<Policy>();
 			}
 		}
 
-		// Handle timeslice pre-emption for RR if we're not done
-		if (algo == SchedulingAlgorithm::RoundRobin) {
-			mQuantumTimer++;
+		// Handle timeslice pre-emption (RR / MLFQ) if we're not done
+		const std::uint64_t quantum = Policy::HasQuantum(mAlgorithm) ? scheduler.GetTimeQuantum(mActiveProcess) : 0;
+		if (quantum && ++mQuantumTimer >= quantum) {
+			ProcessControlBlock* currentPcb = mActiveProcess;
+			scheduler.OnQuantumExpired(currentPcb);
+
+			// Back of the line, if nothing is ahead of it now it keeps the CPU with a fresh quantum
+			Requeue<Policy>(currentPcb);
+			ProcessControlBlock* next = scheduler.PopNext();
+
+			if (!next) {
+				ThreadPrint("PID[", currentPcb->mProcessIdentifier, "] TIMESLICE ENDED");
+				Unload();
+			} else if (next != currentPcb) {
+				ThreadPrint("PID[", currentPcb->mProcessIdentifier, "] TIMESLICE ENDED");
+				ContextSwitch(next);
+			} else {
+				LeaveReady(currentPcb);
+				mQuantumTimer = 0;
+			}
 
-			if (mQuantumTimer >= cfg::gRoundRobinTimeQuantum) {
-				if (!mScheduler->GetReadyList().empty()) {
-					// If there is a process after this, we'll transition to that one
-					ThreadPrint("[RR] TIMESLICE ENDED");
+			return;
+		}
 
-					ProcessControlBlock* currentPcb = mActiveProcess;
-					ContextSwitch(mScheduler->PopNext());
-					mScheduler->OnReadyProcess(currentPcb);
-				} else {
-					// No context switch occurs but we'll get a fresh quantum regardless
-					mQuantumTimer = 0;
-				}
+		// Otherwise the scheduler might want the CPU back anyway (e.g. CFS once the slice is used up)
+		if (Policy::HasRunningHooks(mAlgorithm) && !mIsDispatching && scheduler.ShouldPreemptNow(mActiveProcess)) {
+			ProcessControlBlock* oldActive = mActiveProcess;
+			if (ProcessControlBlock* next = scheduler.PopNext()) {
+				ContextSwitch(next);
+			} else {
+				Unload();
 			}
+
+			Requeue<Policy>(oldActive);
 		}
 
 		return;
 	}
 
 	// No active PCB at the moment, let the scheduler decide!
-	ProcessControlBlock* next = mScheduler->PopNext();
+	ProcessControlBlock* next = scheduler.PopNext();
 
 	if (next) {
 		ContextSwitch(next);
-	} else if (!mIsIdle) {
+		return;
+	}
+
+	if (!mIsIdle) {
 		mIsIdle        = true;
 		mIdleStartTime = std::chrono::steady_clock::now();
+		mIdleStartTick = mTick;
 	}
+
+	mIdleTicks++;
+	WaitForWork();
 }
 
-void CPU::HandlePriorityAging()
+template <typename Policy>
+void CPU::FastForward()
 {
-	const auto& readyList                 = mScheduler->GetReadyList();
-	ProcessControlBlock* highestPrioReady = nullptr;
+	// Only a running CPU burst can be skipped through, everything else wants a real tick
+	if (!mActiveProcess || mActiveProcess->mState.load() != ProcessState::Running) {
+		return;
+	}
 
-	for (ProcessControlBlock* process : readyList) {
-		// Skip the currently active process
-		if (process == mActiveProcess) {
-			continue;
+	ProcessWork* burst = mActiveProcess->mProcess.GetBurst();
+	if (!burst || burst->mType != ProcessWork::Type::CPU || burst->GetRemaining() <= 1) {
+		return;
+	}
+
+	typename Policy::Scheduler& scheduler = GetPolicyScheduler<Policy>();
+
+	// Stop a tick short of the burst completing
+	std::uint64_t skip = burst->GetRemaining() - 1;
+
+	// ... and of the quantum expiring
+	const std::uint64_t quantum = Policy::HasQuantum(mAlgorithm) ? scheduler.GetTimeQuantum(mActiveProcess) : 0;
+	if (quantum) {
+		if (mQuantumTimer + 1 >= quantum) {
+			return;
+		}
+
+		skip = std::min(skip, quantum - mQuantumTimer - 1);
+	}
+
+	// ... and of the scheduler wanting the CPU back
+	if (Policy::HasRunningHooks(mAlgorithm)) {
+		const std::uint64_t horizon = scheduler.GetPreemptHorizon(mActiveProcess);
+		if (horizon <= 1) {
+			return;
+		}
+
+		skip = std::min(skip, horizon - 1);
+	}
+
+	// ... and of the scheduler's periodic work
+	if (Policy::HasPeriod(mAlgorithm) && mSchedulerPeriod) {
+		if (mNextPeriodTick <= mTick + 1) {
+			return;
 		}
 
-		// Handle priority aging for the process
-		std::uint64_t& prioTimer = process->mInactivePriorityTimer;
-		if (++prioTimer > 5000) {
-			// Check against the max value for the priority type
-			if (process->mPriority < std::numeric_limits<decltype(process->mPriority)>::max()) {
-				++process->mPriority;
-				ThreadPrint("[PRIO] PID[", process->mProcessIdentifier, "] BUMPED TO [", process->mPriority, "]");
+		skip = std::min(skip, mNextPeriodTick - mTick - 1);
+	}
+
+	// ... and of the next decay tick, or of any ready process aging
+	if (Policy::HasAging(mAlgorithm)) {
+		const std::uint64_t nextDecay = (mTick / PriorityDecayTicks + 1) * PriorityDecayTicks;
+		skip                          = std::min(skip, nextDecay - mTick - 1);
+
+		// Anything that would preempt or age has to be handled by a real tick
+		if (mProcessTable.GetMaxReadyPriority() > mActiveProcess->mPriority) {
+			return;
+		}
+
+		if (!mAgingQueue.IsEmpty()) {
+			const std::uint64_t nextBump = GetNextBumpTick();
+			if (nextBump <= mAgingTick + 1) {
+				return;
 			}
 
-			prioTimer = 0;
+			skip = std::min(skip, nextBump - mAgingTick - 1);
 		}
+	}
 
-		// Keep track of the highest priority ready process found so far
-		if (!highestPrioReady || process->mPriority > highestPrioReady->mPriority) {
-			highestPrioReady = process;
+	// ... and of the next event firing
+	if (!mEvents.IsEmpty()) {
+		const std::uint64_t nextEvent = mEvents.GetNextTime();
+		if (nextEvent <= mTick + 1) {
+			return;
 		}
+
+		skip = std::min(skip, nextEvent - mTick - 1);
 	}
 
-	// Perform the preemption check after the loop
-	if (highestPrioReady && mActiveProcess && highestPrioReady->mPriority > mActiveProcess->mPriority) {
-		ThreadPrint("[PRIO] PID[", highestPrioReady->mProcessIdentifier, "] (PRIO ", highestPrioReady->mPriority, ") PREEMPTS PID[",
-		            mActiveProcess->mProcessIdentifier, "] (PRIO ", mActiveProcess->mPriority, ") AFTER AGING");
+	if (skip == 0) {
+		return;
+	}
 
-		ProcessControlBlock* oldActive = mActiveProcess;
-		ContextSwitch(mScheduler->PopNext());
-		mScheduler->OnReadyProcess(oldActive);
+	// Apply everything the skipped ticks would have done
+	mTick += skip;
+	burst->Advance(static_cast<std::uint32_t>(skip));
+	mActiveProcess->mProgramCounter += static_cast<std::uint32_t>(skip);
+
+	if (Policy::HasRunningHooks(mAlgorithm)) {
+		scheduler.OnRunning(mActiveProcess, skip);
 	}
-}
 
-void CPU::CheckPriorityPreempts()
-{
-	const auto& readyList                 = mScheduler->GetReadyList();
-	ProcessControlBlock* highestPrioReady = nullptr;
+	if (quantum) {
+		mQuantumTimer += skip;
+	}
 
-	for (ProcessControlBlock* process : readyList) {
-		// Skip current process
-		if (process == mActiveProcess) {
-			continue;
-		}
+	if (Policy::HasAging(mAlgorithm)) {
+		mAgingTick += skip;
+	}
+}
 
-		if (!highestPrioReady || process->mPriority > highestPrioReady->mPriority) {
-			highestPrioReady = process;
+template <typename Policy>
+void CPU::HandlePriorityAging()
+{
+	// Whoever has waited longest is the only one that can be due, so a tick where nobody is costs a single comparison
+	while (!mAgingQueue.IsEmpty() && GetNextBumpTick() <= mAgingTick) {
+		ProcessControlBlock* process = mAgingQueue.Top();
+		mAgingQueue.Update(process, mAgingTick);
+
+		// Check against the max value for the priority type
+		if (process->mPriority < std::numeric_limits<decltype(process->mPriority)>::max()) {
+			++process->mPriority;
+			GetPolicyScheduler<Policy>().OnPriorityChanged(process);
+			mProcessTable.SetPriority(process->mProcessIdentifier, process->mPriority);
+			ThreadPrint("[PRIO] PID[", process->mProcessIdentifier, "] BUMPED TO [", process->mPriority, "]");
 		}
 	}
 
+	// Perform the preemption check after the loop
+	CheckPriorityPreempts<Policy>();
+}
+
+template <typename Policy>
+void CPU::CheckPriorityPreempts()
+{
+	typename Policy::Scheduler& scheduler = GetPolicyScheduler<Policy>();
+
+	// Against whoever the scheduler would pick, not simply the highest priority ready (with groups, that may not be allowed to run)
+	ProcessControlBlock* highestPrioReady = mActiveProcess ? scheduler.PeekNext() : nullptr;
+
 	// After everything, check if preemption is OK
-	if (highestPrioReady && mActiveProcess && highestPrioReady->mPriority > mActiveProcess->mPriority) {
+	if (highestPrioReady && highestPrioReady->mPriority > mActiveProcess->mPriority) {
 		ThreadPrint("[PRIO] PID[", highestPrioReady->mProcessIdentifier, "] (PRIO ", highestPrioReady->mPriority, ") PREEMPTS PID[",
 		            mActiveProcess->mProcessIdentifier, "] (PRIO ", mActiveProcess->mPriority, ") AFTER AGING");
 
 		ProcessControlBlock* oldActive = mActiveProcess;
-		ContextSwitch(mScheduler->PopNext());
-		mScheduler->OnReadyProcess(oldActive);
+		ContextSwitch(scheduler.PopNext());
+		Requeue<Policy>(oldActive);
 	}
-}
\ No newline at end of file
+}
+
+// Every loop main.cpp can pick from, one per algorithm on its own and one per algorithm inside groups
+template CPU::TickLoop CPU::GetTickLoop<StaticPolicy<SchedulingAlgorithm::FCFS, FCFSScheduler>>();
+template CPU::TickLoop CPU::GetTickLoop<StaticPolicy<SchedulingAlgorithm::SJF, SJFScheduler>>();
+template CPU::TickLoop CPU::GetTickLoop<StaticPolicy<SchedulingAlgorithm::SRTF, SRTFScheduler>>();
+template CPU::TickLoop CPU::GetTickLoop<StaticPolicy<SchedulingAlgorithm::RoundRobin, RRScheduler>>();
+template CPU::TickLoop CPU::GetTickLoop<StaticPolicy<SchedulingAlgorithm::Priority, PriorityScheduler>>();
+template CPU::TickLoop CPU::GetTickLoop<StaticPolicy<SchedulingAlgorithm::MLFQ, MLFQScheduler>>();
+template CPU::TickLoop CPU::GetTickLoop<StaticPolicy<SchedulingAlgorithm::Fair, FairScheduler>>();
+template CPU::TickLoop CPU::GetTickLoop<StaticPolicy<SchedulingAlgorithm::EDF, EDFScheduler>>();
+
+template CPU::TickLoop CPU::GetTickLoop<StaticPolicy<SchedulingAlgorithm::FCFS, GroupScheduler>>();
+template CPU::TickLoop CPU::GetTickLoop<StaticPolicy<SchedulingAlgorithm::SJF, GroupScheduler>>();
+template CPU::TickLoop CPU::GetTickLoop<StaticPolicy<SchedulingAlgorithm::SRTF, GroupScheduler>>();
+template CPU::TickLoop CPU::GetTickLoop<StaticPolicy<SchedulingAlgorithm::RoundRobin, GroupScheduler>>();
+template CPU::TickLoop CPU::GetTickLoop<StaticPolicy<SchedulingAlgorithm::Priority, GroupScheduler>>();
+template CPU::TickLoop CPU::GetTickLoop<StaticPolicy<SchedulingAlgorithm::MLFQ, GroupScheduler>>();
+template CPU::TickLoop CPU::GetTickLoop<StaticPolicy<SchedulingAlgorithm::Fair, GroupScheduler>>();
+template CPU::TickLoop CPU::GetTickLoop<StaticPolicy<SchedulingAlgorithm::EDF, GroupScheduler>>();
@@ -1,12 +1,25 @@
 #ifndef _CPU_HPP
 #define _CPU_HPP
 
+#include <condition_variable>
 #include <chrono>
 #include <memory>
+#include <vector>
+#include <span>
+#include <deque>
+#include <atomic>
 #include <mutex>
 
 #include "InterruptController.hpp"
+#include "Arena.hpp"
+#include "EventQueue.hpp"
+#include "IndexedHeap.hpp"
+#include "PidAllocator.hpp"
+#include "DeadlineStats.hpp"
+#include "ProcessTable.hpp"
 #include "IScheduler.hpp"
+#include "CpuPolicy.hpp"
+#include "predict/IBurstPredictor.hpp"
 #include "util.hpp"
 
 class Process;
@@ -22,26 +35,63 @@ public:
 
 	CPU(std::unique_ptr<IScheduler> scheduler)
 	    : mScheduler(std::move(scheduler))
+	    , mAlgorithm(mScheduler->GetAlgorithm())
+	    , mIrqController(*this)
 	    , mActiveProcess(nullptr)
 	{
 	}
 
 	~CPU() = default;
 
+	// Ready processes get bumped after waiting this long, running processes decay on every multiple of the other
+	static constexpr std::uint64_t PriorityAgingTicks = 5000;
+	static constexpr std::uint64_t PriorityDecayTicks = 1500;
+
 	void TerminateProcess(ProcessControlBlock* process);
 	void AddProcess(ProcessControlBlock* process);
+
+	// The same as TerminateProcess() / re-readying each in turn, but the scheduler takes the whole batch in one go
+	void TerminateBatch(std::span<ProcessControlBlock* const> batch);
+	void AddReadyBatch(std::span<ProcessControlBlock* const> batch);
+
+	// The same as AddProcess() on each newly created process in turn, those admitted straight away being readied as one batch
+	void AddProcessBatch(std::span<ProcessControlBlock* const> batch);
 	void AssignPID(ProcessControlBlock& process);
 	void ContextSwitch(ProcessControlBlock* next);
+
+	// Takes the running process off the CPU with nothing to replace it, for when the scheduler won't let anything run right now
+	void Unload();
 	void SleepForTime(std::uint64_t amount);
 	void Run();
-	void Step();
+
+	// Every tick is run by one of the loops in CPU.cpp, compiled for a 'CpuPolicy' (see 'CpuPolicy.hpp')
+	using TickLoop = void (CPU::*)();
+
+	// The loop compiled for 'Policy', only for a CPU whose scheduler is a 'Policy::Scheduler' running 'Policy::Algorithm'
+	template <typename Policy>
+	static TickLoop GetTickLoop();
+
+	// The loop Run() goes through (nullptr - the dynamic one, which copes with any scheduler)
+	inline void SetTickLoop(TickLoop loop) { mTickLoop = loop; }
+
+	// Safe from any thread, rouses the CPU if it's parked (idle or dispatching)
+	void Wake();
 
 	inline const std::unique_ptr<IScheduler>& GetScheduler() const { return mScheduler; }
+	inline SchedulingAlgorithm GetAlgorithm() const { return mAlgorithm; }
+	inline Arena& GetArena() { return mArena; }
 	inline ProcessControlBlock* GetCurrentProcess() { return mActiveProcess; }
+	inline std::uint64_t GetTick() const { return mTick; }
+	inline std::uint64_t GetStepCount() const { return mStepCount; }
+	inline EventQueue& GetEventQueue() { return mEvents; }
+	inline BurstPredictionStats& GetPredictionStats() { return mPredictionStats; }
+	inline DeadlineStats& GetDeadlineStats() { return mDeadlineStats; }
 
-	inline bool IsPreemptionAllowed() const
+	inline bool IsPreemptionAllowed() const { return IsPreemptionAllowed(mAlgorithm); }
+
+	static constexpr bool IsPreemptionAllowed(SchedulingAlgorithm algo)
 	{
-		switch (mScheduler->GetAlgorithm()) {
+		switch (algo) {
 		case SchedulingAlgorithm::FCFS:
 		case SchedulingAlgorithm::SJF:
 			return false;
@@ -49,6 +99,9 @@ public:
 		case SchedulingAlgorithm::Priority:
 		case SchedulingAlgorithm::SRTF:
 		case SchedulingAlgorithm::RoundRobin:
+		case SchedulingAlgorithm::MLFQ:
+		case SchedulingAlgorithm::Fair:
+		case SchedulingAlgorithm::EDF:
 			return true;
 		}
 
@@ -56,25 +109,106 @@ public:
 	}
 
 private:
+	template <typename Policy>
+	void RunLoop();
+
+	template <typename Policy>
+	void Step();
+
+	// The scheduler as the type 'Policy' makes its calls through
+	template <typename Policy>
+	inline typename Policy::Scheduler& GetPolicyScheduler() const
+	{
+		return static_cast<typename Policy::Scheduler&>(*mScheduler);
+	}
+
+	// Admission control for a newly created process, true if it can be admitted now (deferring or rejecting it otherwise)
+	bool Screen(ProcessControlBlock* process);
+	void Admit(ProcessControlBlock* process);
+
+	// Hands a process back to the scheduler, its priority aging starting from now
+	template <typename Policy = DynamicPolicy>
+	void Requeue(ProcessControlBlock* pcb);
+
+	// Keep everything the CPU tracks about the ready processes (their aging, the process table) in step with the scheduler
+	void EnterReady(ProcessControlBlock* pcb);
+	void LeaveReady(ProcessControlBlock* pcb);
+
+	void AdmitDeferred();
+	void DeliverEvents();
+
+	// Charges whatever the scheduler has done since the last call as simulated time (see 'SchedulerOverhead')
+	void ChargeSchedulerWork();
+	void WaitForWork();
+	bool WaitForDispatch();
+	void FinishDispatch();
+
+	template <typename Policy>
+	void FastForward();
+
+	template <typename Policy>
 	void HandlePriorityAging();
+
+	template <typename Policy>
 	void CheckPriorityPreempts();
 
-	// Synchronisation
-	std::mutex mMutex;
-	std::uint64_t mTick = 0;
+	// The aging tick the longest waiting ready process gets its next bump on
+	inline std::uint64_t GetNextBumpTick() const { return mAgingQueue.TopKey() + PriorityAgingTicks + 1; }
+
+	// Every PCB and burst, declared first so it's destroyed last (the PCBs outlive everything that points at them)
+	Arena mArena;
+
+	// Timing, everything in here is only ever touched by the CPU thread
+	std::uint64_t mTick      = 0;
+	std::uint64_t mStepCount = 0; // How many times Step() has actually run
 
 	// Scheduling
-	std::uint64_t mQuantumTimer = 0;
+	std::uint64_t mQuantumTimer    = 0;
+	std::uint64_t mSchedulerPeriod = 0; // Cached IScheduler::GetPeriod()
+	std::uint64_t mNextPeriodTick  = 0;
 	std::unique_ptr<IScheduler> mScheduler;
+	SchedulingAlgorithm mAlgorithm; // Cached IScheduler::GetAlgorithm(), it never changes
+	TickLoop mTickLoop = nullptr;
+	BurstPredictionStats mPredictionStats;
+	DeadlineStats mDeadlineStats;
+	std::size_t mCreatedCount = 0;               // Every process screened, whether it was admitted, deferred or rejected
+	std::deque<ProcessControlBlock*> mDeferred;  // Created, but held back by admission control until there's room
+	std::vector<ProcessControlBlock*> mAdmitted; // AddProcessBatch() scratch, those let straight in
+
+	// Scheduler overhead, only counted while it's being charged
+	SchedulerWork mSchedulerWork;         // Everything the scheduler has done over the run
+	std::uint64_t mOverheadTicks     = 0; // ... and what it was charged
+	std::uint64_t mOverheadRemainder = 0; // Nanoseconds of work not yet making up a whole tick, carried into the next charge
+	std::uint64_t mOverheadOwed      = 0; // Virtual time only, ticks charged but not yet paid (a jump never passes a decay tick or event)
+
+	// Priority aging, in ticks that Step() has actually run (so never while dispatching or handling an interrupt)
+	// - Every ready process is queued by the aging tick it became ready or was last bumped on, oldest first
+	std::uint64_t mAgingTick = 0;
+	IndexedHeap<ProcessControlBlock*, std::uint64_t> mAgingQueue;
 
 	// Interrupts & Processes
+	EventQueue mEvents; // Only used in virtual time
 	InterruptController mIrqController;
 	ProcessControlBlock* mActiveProcess = nullptr;
+	PidAllocator mPids;          // Every PID handed out and not yet given back by TerminateProcess()
+	ProcessTable mProcessTable; // The ready processes' hot fields, a row per PID
+
+	// Dispatching (the next PCB is being loaded)
+	bool mIsDispatching            = false;
+	std::uint64_t mDispatchEndTick = 0;
+	SteadyTimePoint mDispatchDeadline;
+
+	// Idling (the CPU thread parks here in real time until an interrupt is posted)
+	std::mutex mIdleMutex;
+	std::condition_variable mIdleCv;
+	bool mWakePending = false;
 
 	// State
 	SteadyTimePoint mIdleStartTime;
-	bool mIsActive = true;
-	bool mIsIdle   = true;
+	std::uint64_t mIdleStartTick = 0;
+	std::uint64_t mIdleTicks     = 0; // Total ticks spent without anything to run
+	std::atomic<bool> mIsActive  = true;
+	bool mIsIdle                 = true;
 };
 
 #endif
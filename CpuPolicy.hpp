@@ -0,0 +1,54 @@
+#ifndef _CPUPOLICY_HPP
+#define _CPUPOLICY_HPP
+
+#include <type_traits>
+
+#include "IScheduler.hpp"
+
+class GroupScheduler;
+
+// What the CPU's tick loop needs to know about the scheduler it's running, so 'CPU::Step()' can be compiled once per algorithm
+// - 'Scheduler' is the type every call from the loop goes through, with a final class they're direct calls instead of virtual ones
+// - The Has*() checks say which parts of the loop an algorithm uses at all, anything it doesn't is folded away
+// - Every check is handed the algorithm the CPU runs, only the dynamic policy looks at it
+
+// The generic loop, copes with any scheduler (e.g. one wrapped by a benchmark) by deciding everything at runtime
+struct DynamicPolicy {
+	using Scheduler = IScheduler;
+
+	static constexpr bool IsDynamic = true;
+
+	static constexpr bool HasAging(SchedulingAlgorithm algo) { return algo == SchedulingAlgorithm::Priority; }
+	static constexpr bool HasQuantum(SchedulingAlgorithm) { return true; }
+	static constexpr bool HasRunningHooks(SchedulingAlgorithm) { return true; }
+	static constexpr bool HasPeriod(SchedulingAlgorithm) { return true; }
+};
+
+// A loop for one algorithm, run by 'SchedulerType' on its own or inside groups ('GroupScheduler')
+template <SchedulingAlgorithm Algo, typename SchedulerType>
+struct StaticPolicy {
+	using Scheduler = SchedulerType;
+
+	static constexpr bool IsDynamic                = false;
+	static constexpr SchedulingAlgorithm Algorithm = Algo;
+
+	// Groups can time slice, take the CPU back and have periodic work whatever algorithm they use
+	static constexpr bool IsGrouped = std::is_same_v<SchedulerType, GroupScheduler>;
+
+	// Priority aging, decay and the preemptions they cause
+	static constexpr bool HasAging(SchedulingAlgorithm) { return Algo == SchedulingAlgorithm::Priority; }
+
+	// GetTimeQuantum() / OnQuantumExpired()
+	static constexpr bool HasQuantum(SchedulingAlgorithm)
+	{
+		return IsGrouped || Algo == SchedulingAlgorithm::RoundRobin || Algo == SchedulingAlgorithm::MLFQ;
+	}
+
+	// OnRunning(), ShouldPreemptNow() and GetPreemptHorizon()
+	static constexpr bool HasRunningHooks(SchedulingAlgorithm) { return IsGrouped || Algo == SchedulingAlgorithm::Fair; }
+
+	// GetPeriod() / OnPeriodic()
+	static constexpr bool HasPeriod(SchedulingAlgorithm) { return IsGrouped || Algo == SchedulingAlgorithm::MLFQ; }
+};
+
+#endif
@@ -0,0 +1,34 @@
+#include "DeadlineStats.hpp"
+#include "util.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+void DeadlineStats::Record(std::uint64_t deadline, std::uint64_t completion)
+{
+	mBursts++;
+	if (completion <= deadline) {
+		return;
+	}
+
+	const std::uint64_t lateness = completion - deadline;
+	mMissed++;
+	mTotalLateness += lateness;
+	mMaxLateness = std::max(mMaxLateness, lateness);
+}
+
+void DeadlineStats::Print() const
+{
+	if (mDeferred || mRejected) {
+		ThreadPrint("ADMISSION CONTROL DEFERRED [", mDeferred, "] REJECTED [", mRejected, "] PROCESSES\r\n");
+	}
+
+	if (!mBursts) {
+		return;
+	}
+
+	const double missRate = 100.0 * static_cast<double>(mMissed) / static_cast<double>(mBursts);
+	const double average  = mMissed ? static_cast<double>(mTotalLateness) / static_cast<double>(mMissed) : 0.0;
+	ThreadPrint("DEADLINES MISSED [", mMissed, " / ", mBursts, "] (", std::fixed, std::setprecision(2), missRate, "%) LATE BY AVG [",
+	            average, " ticks] MAX [", mMaxLateness, " ticks]\r\n");
+}
@@ -0,0 +1,21 @@
+#ifndef _DEADLINESTATS_HPP
+#define _DEADLINESTATS_HPP
+
+#include <cstdint>
+
+// How the deadlines went over a run, fed every time a CPU burst with one completes
+struct DeadlineStats {
+	void Record(std::uint64_t deadline, std::uint64_t completion);
+	void Print() const;
+
+	std::uint64_t mBursts        = 0;
+	std::uint64_t mMissed        = 0;
+	std::uint64_t mTotalLateness = 0; // Over the missed bursts only
+	std::uint64_t mMaxLateness   = 0;
+
+	// Admission control
+	std::uint64_t mDeferred = 0;
+	std::uint64_t mRejected = 0;
+};
+
+#endif
@@ -0,0 +1,32 @@
+#include "EventQueue.hpp"
+
+EventQueue::Handle EventQueue::Push(std::uint64_t when, SimEvent::Type type, ProcessControlBlock* pcb, std::uint32_t device)
+{
+	SimEvent event;
+	event.mWhen   = when;
+	event.mType   = type;
+	event.mPcb    = pcb;
+	event.mDevice = device;
+	return mWheel.Insert(when, event);
+}
+
+bool EventQueue::Cancel(Handle handle) { return mWheel.Cancel(handle); }
+
+bool EventQueue::PopDue(std::uint64_t now, SimEvent& out)
+{
+	// Grab the next batch when we've handed out the last one
+	if (mDueHead == mDue.size()) {
+		mDue.clear();
+		mDueHead = 0;
+
+		mWheel.Advance(now, mDue);
+		if (mDue.empty()) {
+			return false;
+		}
+	}
+
+	out = mDue[mDueHead++];
+	return true;
+}
+
+std::uint64_t EventQueue::GetNextTime() const { return mDueHead < mDue.size() ? mDue[mDueHead].mWhen : mWheel.GetNextExpiry(); }
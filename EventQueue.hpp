@@ -0,0 +1,57 @@
+#ifndef _EVENTQUEUE_HPP
+#define _EVENTQUEUE_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "TimingWheel.hpp"
+#include "util.hpp"
+
+struct ProcessControlBlock;
+
+// Something that will happen at a specific point in virtual time
+struct SimEvent {
+	enum class Type {
+		IOComplete = 0, // An I/O burst has finished servicing
+		IrqFlush,       // The interrupt coalescing window is up, deliver whatever has built up
+		AsyncIOComplete, // An asynchronous I/O burst has finished servicing
+	};
+
+	std::uint64_t mWhen       = 0; // The virtual tick this event fires on
+	Type mType                = Type::IOComplete;
+	ProcessControlBlock* mPcb = nullptr;
+	std::uint32_t mDevice     = 0; // IOComplete only, the device that serviced it
+};
+
+// Global queue of everything that is pending in virtual time, events on the same tick fire in the order they were pushed
+class EventQueue {
+public:
+	NON_COPYABLE(EventQueue)
+
+	using Handle                          = TimingWheel<SimEvent>::Handle;
+	static constexpr Handle InvalidHandle = TimingWheel<SimEvent>::InvalidHandle;
+
+	EventQueue()  = default;
+	~EventQueue() = default;
+
+	Handle Push(std::uint64_t when, SimEvent::Type type, ProcessControlBlock* pcb, std::uint32_t device = 0);
+
+	// False if the event has already fired
+	bool Cancel(Handle handle);
+
+	// Pops the next event due on or before 'now', false if there isn't one
+	bool PopDue(std::uint64_t now, SimEvent& out);
+
+	// Earliest tick an event could fire on, far off events may report slightly early (never late)
+	std::uint64_t GetNextTime() const;
+
+	inline bool IsEmpty() const { return mWheel.IsEmpty() && mDueHead == mDue.size(); }
+	inline std::size_t GetSize() const { return mWheel.GetSize() + (mDue.size() - mDueHead); }
+
+private:
+	TimingWheel<SimEvent> mWheel;
+	std::vector<SimEvent> mDue; // The last batch to expire, handed out one at a time
+	std::size_t mDueHead = 0;
+};
+
+#endif
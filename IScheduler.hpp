@@ -1,9 +1,14 @@
 #ifndef _SCHEDULER_HPP
 #define _SCHEDULER_HPP
 
+#include <functional>
+#include <algorithm>
+#include <utility>
+#include <chrono>
+#include <limits>
+#include <bit>
 #include <vector>
-#include <deque>
-#include <shared_mutex>
+#include <span>
 #include "util.hpp"
 
 struct ProcessControlBlock;
@@ -14,6 +19,40 @@ enum class SchedulingAlgorithm : std::uint32_t {
 	SRTF,       // Shortest remaining time first (preempt if a new process comes with burst length < current burst)
 	RoundRobin, // Give a quantum (CPU time) to each process so everything gets work done slowly
 	Priority,   // Higher priority -> front of the list
+	MLFQ,       // Multi-level feedback queue, processes sink a level when they use a full quantum and rise again after I/O
+	Fair,       // CFS-style, whoever has had the least (weighted) CPU time runs next
+	EDF,        // Earliest deadline first, the CPU burst due soonest runs (pre-empting anything due later)
+};
+
+// What should happen to a process that's just been created
+enum class Admission {
+	Admit = 0, // Let it in
+	Defer,     // Hold it back until there's room for it
+	Reject,    // Turn it away for good
+};
+
+// How the CPU charges for the scheduler's own work (see 'SchedulerWork')
+enum class SchedulerOverhead : std::uint32_t {
+	None = 0,  // Scheduling decisions are free, only the dispatch latency is paid
+	CostTable, // Every comparison, move and lock costs a fixed number of nanoseconds
+	Measured,  // The real time spent inside the scheduler is charged, as it was measured
+};
+
+// The abstract work a scheduler has done, which the CPU turns into simulated ticks
+struct SchedulerWork {
+	std::uint64_t mComparisons = 0; // Two processes (or their keys) ordered against each other
+	std::uint64_t mMoves       = 0; // A process put into, taken out of or shifted along one of the scheduler's lists
+	std::uint64_t mLocks       = 0; // Calls that change the scheduler, each taking the run queue lock in a real kernel
+	std::uint64_t mNanoseconds = 0; // Real time spent in those calls (measured overhead only)
+
+	SchedulerWork& operator+=(const SchedulerWork& other)
+	{
+		mComparisons += other.mComparisons;
+		mMoves += other.mMoves;
+		mLocks += other.mLocks;
+		mNanoseconds += other.mNanoseconds;
+		return *this;
+	}
 };
 
 struct IScheduler {
@@ -23,11 +62,24 @@ struct IScheduler {
 	// 'GETTER' FUNCTIONS //
 	////////////////////////
 	
-	virtual std::vector<ProcessControlBlock*> GetProcessList() const = 0;
-	virtual std::vector<ProcessControlBlock*> GetReadyList() const = 0;
+	// Called with one process after another for as long as it returns true
+	using Visitor = std::function<bool(ProcessControlBlock*)>;
+
+	// Calls 'visit' on every process in the system (ready, running or blocked), false if it stopped early
+	// NOTE: the scheduler's own containers are walked in place, nothing is copied. So 'visit' mustn't change the scheduler
+	//       (it's only ever called on the CPU thread, which is the only one that does)
+	virtual bool VisitProcesses(const Visitor& visit) const = 0;
+
+	// ... and on every ready process, not necessarily in the order they'll be picked
+	virtual bool VisitReady(const Visitor& visit) const = 0;
+
+	virtual std::size_t GetProcessCount() const = 0;
+	virtual std::size_t GetReadyCount() const   = 0;
+
+	inline bool IsReadyEmpty() const { return GetReadyCount() == 0; }
 
 	// Check if the full process list is empty (not the ready queue)
-	virtual bool IsFullProcessListEmpty() const = 0;
+	inline bool IsFullProcessListEmpty() const { return GetProcessCount() == 0; }
 
 	// Gets the algorithm 'this' Scheduler implements
 	virtual SchedulingAlgorithm GetAlgorithm() const = 0;
@@ -39,6 +91,9 @@ struct IScheduler {
 	// Selects and pops next process (or nullptr)
 	virtual ProcessControlBlock* PopNext() = 0;
 
+	// Selects the process PopNext() would return, without removing it (or nullptr)
+	virtual ProcessControlBlock* PeekNext() = 0;
+
 	// Called when a process first enters the system (after PCB assignment, etc.)
 	virtual void OnNewProcess(ProcessControlBlock*) = 0;
 
@@ -47,6 +102,178 @@ struct IScheduler {
 
 	// Removing a certain process from all data structures in the scheduler
 	virtual void OnTerminate(ProcessControlBlock*) = 0;
+
+	// Called when a ready process' priority is changed from outside (e.g. aging), so it can be re-queued
+	virtual void OnPriorityChanged(ProcessControlBlock*) = 0;
+
+	// Called when 'incoming' becomes ready while 'current' is on the CPU, true if 'incoming' should take over
+	// NOTE: only ever called on the CPU thread, the scheduler must not context switch by itself
+	virtual bool ShouldPreempt(ProcessControlBlock* current, ProcessControlBlock* incoming) = 0;
+
+	///////////////////////////////////////////////
+	// BATCHES (ONE AT A TIME UNLESS OVERRIDDEN) //
+	///////////////////////////////////////////////
+
+	// The same as OnReadyProcess() on every process in 'batch' in turn, but one trip into the ready queue for the lot
+	virtual void OnReadyBatch(std::span<ProcessControlBlock* const> batch)
+	{
+		for (ProcessControlBlock* pcb : batch) {
+			OnReadyProcess(pcb);
+		}
+	}
+
+	// The same as OnTerminate() on every process in 'batch', but one pass over the scheduler's lists for the lot
+	virtual void OnTerminateBatch(std::span<ProcessControlBlock* const> batch)
+	{
+		for (ProcessControlBlock* pcb : batch) {
+			OnTerminate(pcb);
+		}
+	}
+
+	// Pops up to 'out.size()' processes into 'out' in the order PopNext() would give them, returns how many
+	virtual std::size_t PopNextBatch(std::span<ProcessControlBlock*> out)
+	{
+		std::size_t count = 0;
+		while (count < out.size() && (out[count] = PopNext())) {
+			count++;
+		}
+
+		return count;
+	}
+
+	// The processes PopNextBatch() would give, without removing any of them
+	virtual std::size_t PeekNextBatch(std::span<ProcessControlBlock*> out) = 0;
+
+	///////////////////////////////////////
+	// OPTIONAL HOOKS (NO-OP BY DEFAULT) //
+	///////////////////////////////////////
+
+	// Called before a new process enters the system, so the scheduler can keep out anything it can't cope with
+	virtual Admission GetAdmission(const ProcessControlBlock*) const { return Admission::Admit; }
+
+	// How long 'pcb' may run before its time slice is up (0 - until it blocks, finishes or is preempted)
+	virtual std::uint64_t GetTimeQuantum(const ProcessControlBlock*) const { return 0; }
+
+	// Called when one of the running process' CPU bursts completes, 'length' being how long it was
+	virtual void OnBurstComplete(ProcessControlBlock*, std::uint32_t) { }
+
+	// Called when the running process has used its whole time slice, just before it's handed back through OnReadyProcess()
+	virtual void OnQuantumExpired(ProcessControlBlock*) { }
+
+	// Called when the running process gives up the CPU to wait on I/O
+	virtual void OnBlocked(ProcessControlBlock*) { }
+
+	// Called with every tick the running process spends computing (many at once when fast-forwarding), so it can be charged for them
+	virtual void OnRunning(ProcessControlBlock*, std::uint64_t) { }
+
+	// Checked after every tick the running process spends computing, true if it should make way for PopNext() right now
+	// NOTE: if PopNext() has nothing to take over, the CPU idles (e.g. a group out of quota mustn't keep running)
+	virtual bool ShouldPreemptNow(ProcessControlBlock*) { return false; }
+
+	// How many more ticks the running process can compute before ShouldPreemptNow() could first be true, so fast-forward never jumps past it
+	virtual std::uint64_t GetPreemptHorizon(const ProcessControlBlock*) const { return std::numeric_limits<std::uint64_t>::max(); }
+
+	// OnPeriodic() is called every this many ticks (0 - never)
+	virtual std::uint64_t GetPeriod() const { return 0; }
+	virtual void OnPeriodic() { }
+
+	// Prints anything the scheduler measured over the run, after the CPU's own results
+	virtual void PrintStats() const { }
+
+	//////////////
+	// OVERHEAD //
+	//////////////
+
+	// Adds the work done since the last call onto 'work', the scheduler's own count starting over
+	// NOTE: anything the scheduler keeps its processes in that counts for itself (e.g. an 'IndexedHeap') must be collected here too
+	virtual void TakeWork(SchedulerWork& work) { work += std::exchange(mWork, {}); }
+
+protected:
+	// Held for the whole of every call that changes the scheduler, it counts the lock (and times the call if overhead is measured)
+	class LockScope {
+	public:
+		NON_COPYABLE(LockScope)
+
+		explicit LockScope(SchedulerWork& work)
+		    : mWork(work)
+		    , mIsTimed(cfg::gSchedulerOverhead == static_cast<std::uint32_t>(SchedulerOverhead::Measured))
+		{
+			mWork.mLocks++;
+			if (mIsTimed) {
+				mStart = std::chrono::steady_clock::now();
+			}
+		}
+
+		~LockScope()
+		{
+			if (mIsTimed) {
+				const auto elapsed = std::chrono::steady_clock::now() - mStart;
+				mWork.mNanoseconds += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+			}
+		}
+
+	private:
+		SchedulerWork& mWork;
+		bool mIsTimed;
+		std::chrono::steady_clock::time_point mStart;
+	};
+
+	inline LockScope Lock() { return LockScope(mWork); }
+
+	// The same as std::erase() on 'list', counting the search for 'pcb' and everything shuffled up behind it. True if it was there
+	template <typename List>
+	bool Erase(List& list, ProcessControlBlock* pcb)
+	{
+		const auto it = std::find(list.begin(), list.end(), pcb);
+		if (it == list.end()) {
+			mWork.mComparisons += list.size();
+			return false;
+		}
+
+		mWork.mComparisons += static_cast<std::uint64_t>(std::distance(list.begin(), it)) + 1;
+		mWork.mMoves += static_cast<std::uint64_t>(std::distance(it, list.end()));
+		list.erase(it);
+		return true;
+	}
+
+	// Takes everything in 'batch' out of 'list' in one pass (keeping the order of the rest), calling 'onErase' on each one found
+	template <typename List, typename OnErase>
+	void EraseBatch(List& list, std::span<ProcessControlBlock* const> batch, OnErase&& onErase)
+	{
+		if (batch.size() == 1) {
+			if (Erase(list, batch.front())) {
+				onErase(batch.front());
+			}
+
+			return;
+		}
+
+		// Sorted, so checking each entry is a binary search rather than a walk over the batch
+		std::vector<ProcessControlBlock*> sorted(batch.begin(), batch.end());
+		std::sort(sorted.begin(), sorted.end());
+
+		// Roughly: the sort, a binary search per entry, and every entry kept being moved up over the gaps
+		const std::uint64_t depth = std::bit_width(sorted.size());
+		mWork.mComparisons += sorted.size() * depth + list.size() * depth;
+		mWork.mMoves += list.size();
+
+		std::erase_if(list, [&sorted, &onErase](ProcessControlBlock* pcb) {
+			if (!std::binary_search(sorted.begin(), sorted.end(), pcb)) {
+				return false;
+			}
+
+			onErase(pcb);
+			return true;
+		});
+	}
+
+	template <typename List>
+	void EraseBatch(List& list, std::span<ProcessControlBlock* const> batch)
+	{
+		EraseBatch(list, batch, [](ProcessControlBlock*) { });
+	}
+
+	SchedulerWork mWork; // Done since the last TakeWork()
 };
 
 #endif
@@ -0,0 +1,268 @@
+#ifndef _INDEXEDHEAP_HPP
+#define _INDEXEDHEAP_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <algorithm>
+#include <utility>
+#include <unordered_map>
+#include <vector>
+#include <span>
+
+#include "util.hpp"
+
+// Indexed d-ary min heap, O(log n) push / pop / re-key / removal of any value it holds
+// - Ordered by 'Compare' on the key, values with equal keys come out in the order they were pushed
+// - Every value's slot is tracked, so re-keying or removing one never has to search for it
+// Values must be unique (e.g. PCB pointers), keys are copied in so they can't change behind the heap's back
+template <typename T, typename Key, typename Compare = std::less<Key>, std::size_t Arity = 4>
+class IndexedHeap {
+	static_assert(Arity >= 2, "A HEAP NEEDS AT LEAST TWO CHILDREN PER NODE");
+
+public:
+	NON_COPYABLE(IndexedHeap)
+
+	IndexedHeap()  = default;
+	~IndexedHeap() = default;
+
+	void Push(const T& value, const Key& key)
+	{
+		REQUIRE(!Contains(value));
+
+		mNodes.push_back({ value, key, mNextSequence++ });
+		mPositions[value] = mNodes.size() - 1;
+		SiftUp(mNodes.size() - 1);
+	}
+
+	// The same as Push() on every value in 'values' in turn (so equal keys still come out in that order), 'getKey' giving each one's key
+	// A batch at least as big as the heap already was rebuilds the whole heap bottom-up in O(n), rather than sifting each value in
+	template <typename Range, typename GetKey>
+	void PushBatch(const Range& values, GetKey&& getKey)
+	{
+		const std::size_t held = mNodes.size();
+		mNodes.reserve(held + std::size(values));
+		for (const T& value : values) {
+			REQUIRE(!Contains(value));
+
+			mNodes.push_back({ value, getKey(value), mNextSequence++ });
+			mPositions[value] = mNodes.size() - 1;
+		}
+
+		if (mNodes.size() - held >= held) {
+			// Every parent from the last one back up to the root, each of their subtrees already being a heap
+			for (std::size_t index = mNodes.size() > 1 ? (mNodes.size() - 2) / Arity + 1 : 0; index-- > 0;) {
+				SiftDown(index);
+			}
+
+			return;
+		}
+
+		for (std::size_t index = held; index < mNodes.size(); ++index) {
+			SiftUp(index);
+		}
+	}
+
+	// Moves a value to where its new key belongs (either direction), false if it isn't in the heap
+	bool Update(const T& value, const Key& key)
+	{
+		auto it = mPositions.find(value);
+		if (it == mPositions.end()) {
+			return false;
+		}
+
+		const std::size_t index = it->second;
+		mNodes[index].mKey      = key;
+		if (!SiftUp(index)) {
+			SiftDown(index);
+		}
+
+		return true;
+	}
+
+	// False if the value isn't in the heap
+	bool Remove(const T& value)
+	{
+		auto it = mPositions.find(value);
+		if (it == mPositions.end()) {
+			return false;
+		}
+
+		RemoveAt(it->second);
+		return true;
+	}
+
+	T Pop()
+	{
+		REQUIRE(!mNodes.empty());
+
+		T top = mNodes.front().mValue;
+		RemoveAt(0);
+		return top;
+	}
+
+	// Pops up to 'out.size()' values into 'out' in order, returns how many
+	std::size_t PopBatch(std::span<T> out)
+	{
+		const std::size_t count = std::min(out.size(), mNodes.size());
+		for (std::size_t i = 0; i < count; ++i) {
+			out[i] = Pop();
+		}
+
+		return count;
+	}
+
+	// The first (up to) 'out.size()' values Pop() would give, without popping them, returns how many. O(k log k) for k values
+	std::size_t PeekBatch(std::span<T> out) const
+	{
+		if (out.empty() || mNodes.empty()) {
+			return 0;
+		}
+
+		// Best-first down the tree: the next value is always the earliest of the children of those already taken
+		const auto isLater = [this](std::size_t a, std::size_t b) { return IsBefore(mNodes[b], mNodes[a]); };
+		mFrontier.assign(1, 0);
+
+		std::size_t count = 0;
+		while (count < out.size() && !mFrontier.empty()) {
+			std::pop_heap(mFrontier.begin(), mFrontier.end(), isLater);
+			const std::size_t index = mFrontier.back();
+			mFrontier.pop_back();
+			out[count++] = mNodes[index].mValue;
+
+			const std::size_t first = index * Arity + 1;
+			const std::size_t last  = std::min(first + Arity, mNodes.size());
+			for (std::size_t child = first; child < last; ++child) {
+				mFrontier.push_back(child);
+				std::push_heap(mFrontier.begin(), mFrontier.end(), isLater);
+			}
+		}
+
+		return count;
+	}
+
+	// Adds the comparisons and moves the heap has done since the last call onto the two counts, starting its own over
+	inline void TakeCounts(std::uint64_t& comparisons, std::uint64_t& moves)
+	{
+		comparisons += std::exchange(mComparisons, 0);
+		moves += std::exchange(mMoves, 0);
+	}
+
+	inline const T& Top() const { return mNodes.front().mValue; }
+	inline const Key& TopKey() const { return mNodes.front().mKey; }
+
+	inline bool Contains(const T& value) const { return mPositions.contains(value); }
+	inline std::size_t GetSize() const { return mNodes.size(); }
+	inline bool IsEmpty() const { return mNodes.empty(); }
+
+	// Calls 'visit' on every value in heap (not pop) order until it returns false, false if it did
+	template <typename Visit>
+	bool VisitValues(Visit&& visit) const
+	{
+		return std::all_of(mNodes.begin(), mNodes.end(), [&visit](const Node& node) { return visit(node.mValue); });
+	}
+
+private:
+	struct Node {
+		T mValue;
+		Key mKey;
+		std::uint64_t mSequence; // Push order, breaks ties
+	};
+
+	inline bool IsBefore(const Node& a, const Node& b) const
+	{
+		mComparisons++;
+		if (mCompare(a.mKey, b.mKey)) {
+			return true;
+		}
+
+		if (mCompare(b.mKey, a.mKey)) {
+			return false;
+		}
+
+		return a.mSequence < b.mSequence;
+	}
+
+	inline void Place(std::size_t index, Node&& node)
+	{
+		mMoves++;
+		mNodes[index]                    = std::move(node);
+		mPositions[mNodes[index].mValue] = index;
+	}
+
+	void RemoveAt(std::size_t index)
+	{
+		mPositions.erase(mNodes[index].mValue);
+
+		// Fill the hole with the last node, then let it find its place
+		const std::size_t last = mNodes.size() - 1;
+		if (index != last) {
+			Place(index, std::move(mNodes[last]));
+		}
+
+		mNodes.pop_back();
+		if (index < mNodes.size() && !SiftUp(index)) {
+			SiftDown(index);
+		}
+	}
+
+	// True if the node moved
+	bool SiftUp(std::size_t index)
+	{
+		Node node        = std::move(mNodes[index]);
+		const auto start = index;
+
+		while (index > 0) {
+			const std::size_t parent = (index - 1) / Arity;
+			if (!IsBefore(node, mNodes[parent])) {
+				break;
+			}
+
+			Place(index, std::move(mNodes[parent]));
+			index = parent;
+		}
+
+		Place(index, std::move(node));
+		return index != start;
+	}
+
+	void SiftDown(std::size_t index)
+	{
+		Node node = std::move(mNodes[index]);
+
+		while (true) {
+			// Find the earliest child, if any of them should come before this node
+			const std::size_t first = index * Arity + 1;
+			if (first >= mNodes.size()) {
+				break;
+			}
+
+			std::size_t best       = first;
+			const std::size_t last = std::min(first + Arity, mNodes.size());
+			for (std::size_t child = first + 1; child < last; ++child) {
+				if (IsBefore(mNodes[child], mNodes[best])) {
+					best = child;
+				}
+			}
+
+			if (!IsBefore(mNodes[best], node)) {
+				break;
+			}
+
+			Place(index, std::move(mNodes[best]));
+			index = best;
+		}
+
+		Place(index, std::move(node));
+	}
+
+	std::vector<Node> mNodes;
+	std::unordered_map<T, std::size_t> mPositions; // Where each value currently sits in 'mNodes'
+	std::uint64_t mNextSequence = 0;
+	mutable std::vector<std::size_t> mFrontier; // PeekBatch() scratch, kept so it doesn't allocate on every call
+	mutable std::uint64_t mComparisons = 0;     // Since the last TakeCounts()
+	std::uint64_t mMoves               = 0;
+	[[no_unique_address]] Compare mCompare;
+};
+
+#endif
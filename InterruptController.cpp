@@ -1,13 +1,36 @@
+#include <algorithm>
 #include <iostream>
+#include <iomanip>
 #include <string>
 
 #include "InterruptController.hpp"
+#include "EventQueue.hpp"
 #include "Process.hpp"
 #include "util.hpp"
 #include "CPU.hpp"
+#include "io/FIFOIOScheduler.hpp"
+#include "io/SCANIOScheduler.hpp"
+#include "io/DeadlineIOScheduler.hpp"
 
-InterruptController::InterruptController()
-    : mIoThread([this](std::stop_token st) { this->IOWorker(st); })
+namespace {
+	std::unique_ptr<IIOScheduler> MakeIOScheduler(IOSchedulingPolicy policy)
+	{
+		switch (policy) {
+		case IOSchedulingPolicy::FIFO:
+			return std::make_unique<FIFOIOScheduler>();
+		case IOSchedulingPolicy::SCAN:
+			return std::make_unique<SCANIOScheduler>();
+		case IOSchedulingPolicy::Deadline:
+			return std::make_unique<DeadlineIOScheduler>();
+		}
+
+		PanicExit("UNKNOWN I/O SCHEDULING POLICY SUPPLIED");
+	}
+} // namespace
+
+InterruptController::InterruptController(CPU& parent)
+    : mParent(parent)
+    , mStartTime(std::chrono::steady_clock::now())
 {
 }
 
@@ -19,15 +42,389 @@ InterruptController::~InterruptController()
 	mCv.notify_one();
 }
 
-void InterruptController::NotifyBlocked(ProcessControlBlock* pcb)
+void InterruptController::Start()
 {
-	std::lock_guard lg(mMutex);
+	if (mDevices.empty()) {
+		for (std::uint32_t i = 0; i < cfg::gIoDeviceCount; ++i) {
+			auto scheduler = MakeIOScheduler(static_cast<IOSchedulingPolicy>(cfg::gIoScheduler));
+			mDevices.push_back(std::make_unique<IODevice>("DISK" + std::to_string(i), cfg::gIoQueueDepth, std::move(scheduler)));
+		}
+	}
 
-	// Only enqueue if not already pending
-	REQUIRE(std::find(mNewBlocks.begin(), mNewBlocks.end(), pcb) == mNewBlocks.end());
+	// Virtual time has no need for a worker, completions are events on the CPU's queue
+	if (cfg::gVirtualTime || mIoThread.joinable()) {
+		return;
+	}
 
-	mNewBlocks.push_back(pcb);
-	mCv.notify_one();
+	mIoThread = std::jthread([this](std::stop_token st) { this->IOWorker(st); });
+}
+
+void InterruptController::NotifyBlocked(ProcessControlBlock* pcb) { SubmitIO(pcb, false); }
+
+void InterruptController::SubmitAsync(ProcessControlBlock* pcb)
+{
+	// Its time in flight is only counted once it completes, anything cancelled never adds to the total
+	mAsync[pcb].mSubmitTimes.push_back(GetNow());
+	mAsyncSubmitted++;
+
+	SubmitIO(pcb, true);
+}
+
+bool InterruptController::WaitForAsync(ProcessControlBlock* pcb)
+{
+	auto it = mAsync.find(pcb);
+	if (it == mAsync.end() || it->second.mSubmitTimes.empty()) {
+		return true;
+	}
+
+	it->second.mIsWaiting = true;
+	it->second.mWaitStart = GetNow();
+	mAsyncBlocked++;
+	return false;
+}
+
+std::uint32_t InterruptController::GetOutstandingIO(const ProcessControlBlock* pcb) const
+{
+	auto it = mAsync.find(pcb);
+	return it == mAsync.end() ? 0 : static_cast<std::uint32_t>(it->second.mSubmitTimes.size());
+}
+
+void InterruptController::SubmitIO(ProcessControlBlock* pcb, bool isAsync)
+{
+	// The request is worked out here, the I/O thread never reads the PCB itself
+	const ProcessWork* burst = pcb->mProcess.GetBurst();
+	const std::uint64_t now  = GetNow();
+
+	std::unique_lock lock(mMutex, std::defer_lock);
+	if (!cfg::gVirtualTime) {
+		lock.lock();
+	}
+
+	// Ideal device, the burst is serviced straight away no matter what else is going on
+	if (mDevices.empty()) {
+		ArmTimer(pcb, now + burst->mDuration, 0, isAsync);
+		return;
+	}
+
+	REQUIRE(burst->mDevice < mDevices.size());
+	IODevice& device = *mDevices[burst->mDevice];
+
+	IORequest request;
+	request.mPcb    = pcb;
+	request.mTrack  = burst->mTrack;
+	request.mLength  = burst->mDuration;
+	request.mIsAsync = isAsync;
+
+	pcb->mIoTimer = TimingWheel<Interrupt>::InvalidHandle;
+	device.Submit(request, now);
+	StartRequests(burst->mDevice, now);
+
+	if (!isAsync && pcb->mIoTimer == TimingWheel<Interrupt>::InvalidHandle) {
+		const std::size_t ahead = device.GetInFlight() + device.GetQueueLength() - 1;
+		ThreadPrint("PID[", pcb->mProcessIdentifier, "] - > [BLOCKED ON ", device.GetName(), " BEHIND ", ahead, " REQUESTS]");
+	}
+}
+
+void InterruptController::CancelIO(ProcessControlBlock* pcb)
+{
+	// Blocked at a wait point, nothing of its own to cancel. Whatever's in flight still completes, and is ignored
+	if (pcb->mProcess.GetBurst()->mType == ProcessWork::Type::Wait) {
+		mAsync.erase(pcb);
+		return;
+	}
+
+	std::unique_lock lock(mMutex, std::defer_lock);
+	if (!cfg::gVirtualTime) {
+		lock.lock();
+	}
+
+	// Still queued on its device, it just never gets serviced
+	const std::uint32_t deviceIndex = pcb->mProcess.GetBurst()->mDevice;
+	if (!mDevices.empty() && mDevices[deviceIndex]->Cancel(pcb)) {
+		return;
+	}
+
+	const bool cancelled = cfg::gVirtualTime ? mParent.GetEventQueue().Cancel(pcb->mIoTimer) : mPendingEvents.Cancel(pcb->mIoTimer);
+
+	// Being serviced, abort it so the device can move on (if it had already finished, the device was let go when it fired)
+	if (cancelled && !mDevices.empty()) {
+		OnDeviceFinished(deviceIndex, GetNow());
+	}
+
+	// If it had already fired the interrupt is still in flight, CompleteIO() ignores it as the PCB won't be blocked
+	pcb->mIoTimer = TimingWheel<Interrupt>::InvalidHandle;
+}
+
+void InterruptController::ArmTimer(ProcessControlBlock* pcb, std::uint64_t when, std::uint32_t device, bool isAsync)
+{
+	// Asynchronous bursts are never cancelled, so only the blocking burst's handle is kept on the PCB
+	std::uint64_t handle = TimingWheel<Interrupt>::InvalidHandle;
+
+	if (cfg::gVirtualTime) {
+		const SimEvent::Type type = isAsync ? SimEvent::Type::AsyncIOComplete : SimEvent::Type::IOComplete;
+		handle                    = mParent.GetEventQueue().Push(when, type, pcb, device);
+	} else {
+		Interrupt irq;
+		irq.mPcb     = pcb;
+		irq.mDue     = mStartTime + std::chrono::milliseconds(when);
+		irq.mDevice  = device;
+		irq.mIsAsync = isAsync;
+		handle       = mPendingEvents.Insert(when, irq);
+
+		// Only bother the I/O thread if it would otherwise sleep through this one
+		if (when < mWakeAt) {
+			mRearm = true;
+			mCv.notify_one();
+		}
+	}
+
+	if (!isAsync) {
+		pcb->mIoTimer = handle;
+	}
+}
+
+void InterruptController::StartRequests(std::uint32_t deviceIndex, std::uint64_t now)
+{
+	IODevice& device = *mDevices[deviceIndex];
+
+	IORequest request;
+	std::uint32_t serviceTime = 0;
+	while (device.StartNext(now, request, serviceTime)) {
+		ArmTimer(request.mPcb, now + serviceTime, deviceIndex, request.mIsAsync);
+	}
+}
+
+void InterruptController::OnDeviceFinished(std::uint32_t device, std::uint64_t now)
+{
+	mDevices[device]->Finish();
+	StartRequests(device, now);
+}
+
+std::uint64_t InterruptController::GetElapsedMs() const
+{
+	using namespace std::literals;
+	return static_cast<std::uint64_t>((std::chrono::steady_clock::now() - mStartTime) / 1ms);
+}
+
+std::uint64_t InterruptController::GetNow() const { return cfg::gVirtualTime ? mParent.GetTick() : GetElapsedMs(); }
+
+std::size_t InterruptController::DrainInbox()
+{
+	std::size_t count = 0;
+
+	// The I/O thread has already decided how completions are grouped, so just take an interrupt at the end of each group
+	Interrupt irq;
+	while (mInbox.TryPop(irq)) {
+		mBatch.push_back(irq);
+		count++;
+
+		if (irq.mIsLast) {
+			FlushBatch();
+		}
+	}
+
+	return count;
+}
+
+void InterruptController::OnIOExpired(ProcessControlBlock* pcb, std::uint64_t dueTick, std::uint32_t device, bool isAsync)
+{
+	// The device is free as soon as the transfer's done, whether or not the CPU has taken the interrupt yet
+	if (!mDevices.empty()) {
+		OnDeviceFinished(device, dueTick);
+	}
+
+	Interrupt irq;
+	irq.mPcb     = pcb;
+	irq.mDueTick = dueTick;
+	irq.mIsAsync = isAsync;
+	mBatch.push_back(irq);
+
+	if (!IsCoalescing() || mBatch.size() >= cfg::gIrqCoalesceCount) {
+		FlushBatch();
+		return;
+	}
+
+	// First one in, the window starts now
+	if (mBatch.size() == 1) {
+		mFlushTimer = mParent.GetEventQueue().Push(mParent.GetTick() + cfg::gIrqCoalesceWindow, SimEvent::Type::IrqFlush, nullptr);
+	}
+}
+
+void InterruptController::FlushBatch()
+{
+	if (mBatch.empty()) {
+		return;
+	}
+
+	if (cfg::gVirtualTime) {
+		mParent.GetEventQueue().Cancel(mFlushTimer);
+		mFlushTimer = EventQueue::InvalidHandle;
+	}
+
+	// Entering / leaving the handler costs the same no matter how much work the interrupt carries
+	mInterruptCount++;
+	mHandlingTicks += cfg::gInterruptCost;
+	mParent.SleepForTime(cfg::gInterruptCost);
+
+	if (mBatch.size() == 1) {
+		CompleteIO(mBatch.front().mPcb, mBatch.front().mIsAsync);
+	} else {
+		for (const Interrupt& irq : mBatch) {
+			switch (ReleaseFromIO(irq.mPcb, irq.mIsAsync)) {
+			case Release::Ready:
+				mReadied.push_back(irq.mPcb);
+				break;
+			case Release::Exit:
+				mExited.push_back(irq.mPcb);
+				break;
+			case Release::Nothing:
+			default:
+				break;
+			}
+		}
+
+		// One trip to the scheduler for everything that's finished ...
+		if (!mExited.empty()) {
+			mParent.TerminateBatch(mExited);
+		}
+
+		// ... and one print, one trip and one preemption check for the rest
+		if (!mReadied.empty()) {
+			ThreadPrint("[IRQ] - > [UNBLOCKED ", mReadied.size(), " PROCESSES FROM I/O BURSTS]");
+			mParent.AddReadyBatch(mReadied);
+		}
+
+		mReadied.clear();
+		mExited.clear();
+	}
+
+	// Time from the I/O being due to the CPU having taken it back
+	using namespace std::literals;
+	const auto now = std::chrono::steady_clock::now();
+	for (const Interrupt& irq : mBatch) {
+		if (cfg::gVirtualTime) {
+			RecordLatency(mParent.GetTick() - irq.mDueTick);
+		} else {
+			RecordLatency(static_cast<std::uint64_t>((now - irq.mDue) / 1us));
+		}
+	}
+
+	mBatch.clear();
+}
+
+void InterruptController::PostInterrupt(const Interrupt& irq)
+{
+	// The inbox is bounded, if the CPU has fallen that far behind just give it a moment to catch up
+	while (!mInbox.TryPush(irq)) {
+		mParent.Wake();
+		std::this_thread::yield();
+	}
+
+	mParent.Wake();
+}
+
+void InterruptController::PostBatch(std::vector<Interrupt>& batch)
+{
+	// Split into interrupts of at most 'gIrqCoalesceCount' completions each
+	const std::size_t perInterrupt = IsCoalescing() ? cfg::gIrqCoalesceCount : 1;
+	for (std::size_t i = 0; i < batch.size(); ++i) {
+		batch[i].mIsLast = (i + 1) % perInterrupt == 0 || i + 1 == batch.size();
+		PostInterrupt(batch[i]);
+	}
+
+	batch.clear();
+}
+
+InterruptController::Release InterruptController::ReleaseFromIO(ProcessControlBlock* pcb, bool isAsync)
+{
+	if (isAsync) {
+		auto it = mAsync.find(pcb);
+		if (it == mAsync.end() || it->second.mSubmitTimes.empty()) {
+			return Release::Nothing;
+		}
+
+		// Completions needn't come back in the order they went out, but every submission is matched to one so the total holds
+		AsyncState& state = it->second;
+		mAsyncIoTime += GetNow() - state.mSubmitTimes.front();
+		state.mSubmitTimes.pop_front();
+
+		// Most of the time the process is still busy elsewhere, it'll see this at its wait point
+		if (!state.mSubmitTimes.empty() || !state.mIsWaiting) {
+			return Release::Nothing;
+		}
+
+		mAsyncWaitTime += GetNow() - state.mWaitStart;
+		mAsync.erase(it);
+	}
+
+	// Terminated while it was blocked, nothing to complete
+	if (pcb->mState.load() != ProcessState::Blocked) {
+		return Release::Nothing;
+	}
+
+	pcb->mIoTimer = TimingWheel<Interrupt>::InvalidHandle;
+
+	// Consume the I/O burst (or the wait point)
+	pcb->mProcess.PopCurrentBurst();
+
+	// If there are any bursts remaining, re-ready it
+	if (pcb->mProcess.GetBurst()) {
+		pcb->mState.store(ProcessState::Ready);
+		return Release::Ready;
+	}
+
+	ThreadPrint("PID[", pcb->mProcessIdentifier, "] - > [EXIT FROM I/O BURST]");
+	pcb->mState.store(ProcessState::Terminated);
+	return Release::Exit;
+}
+
+void InterruptController::CompleteIO(ProcessControlBlock* pcb, bool isAsync)
+{
+	switch (ReleaseFromIO(pcb, isAsync)) {
+	case Release::Ready:
+		ThreadPrint("PID[", pcb->mProcessIdentifier, "] - > [UNBLOCKED FROM I/O BURST]");
+		mParent.AddProcess(pcb);
+		break;
+	case Release::Exit:
+		mParent.TerminateProcess(pcb);
+		break;
+	case Release::Nothing:
+	default:
+		break;
+	}
+}
+
+void InterruptController::RecordLatency(std::uint64_t latency)
+{
+	mCompletionCount++;
+	mTotalLatency += latency;
+	mMaxLatency = std::max(mMaxLatency, latency);
+}
+
+void InterruptController::PrintStats() const
+{
+	if (!mCompletionCount) {
+		return;
+	}
+
+	const char* unit = cfg::gVirtualTime ? " ticks" : "us";
+	ThreadPrint("I/O COMPLETIONS [", mCompletionCount, "] LATENCY AVG [", mTotalLatency / mCompletionCount, unit, "] MAX [", mMaxLatency,
+	            unit, "]");
+
+	for (const auto& device : mDevices) {
+		device->PrintStats(GetNow());
+	}
+
+	if (mAsyncSubmitted) {
+		// How much of the asynchronous I/O time the processes spent doing something other than waiting on it
+		const double overlap = mAsyncIoTime ? 100.0 * (1.0 - static_cast<double>(mAsyncWaitTime) / static_cast<double>(mAsyncIoTime)) : 100.0;
+		ThreadPrint("ASYNC I/O [", mAsyncSubmitted, "] IN FLIGHT FOR [", mAsyncIoTime, " ticks] BLOCKED [", mAsyncBlocked, "] WAITS FOR [",
+		            mAsyncWaitTime, " ticks] (", std::fixed, std::setprecision(2), overlap, "% OVERLAPPED)");
+	}
+
+	ThreadPrint("INTERRUPTS TAKEN [", mInterruptCount, "] (", std::fixed, std::setprecision(2),
+	            static_cast<double>(mCompletionCount) / static_cast<double>(std::max<std::uint64_t>(mInterruptCount, 1)),
+	            " COMPLETIONS EACH) COSTING [", mHandlingTicks, " ticks]\r\n");
 }
 
 void InterruptController::IOWorker(std::stop_token st)
@@ -35,50 +432,50 @@ void InterruptController::IOWorker(std::stop_token st)
 	std::unique_lock lock(mMutex);
 
 	while (!st.stop_requested()) {
-		// Add any new blocks to the pending events list
-		auto now = std::chrono::steady_clock::now();
-		for (ProcessControlBlock* pcb : mNewBlocks) {
-			IOEvent newEvent;
-			newEvent.mPcb  = pcb;
-			newEvent.mWhen = now + std::chrono::milliseconds(pcb->mProcess.GetBurst()->mDuration);
-			mPendingEvents.push(newEvent);
-		}
-		mNewBlocks.clear();
-
-		// Wait for a new blocked process if there are no pending events
-		if (mPendingEvents.empty()) {
-			mCv.wait(lock, [&] { return st.stop_requested() || !mNewBlocks.empty(); });
-			continue;
+		// If your time has come, so be it (every timer in a slot expires together)
+		const std::uint64_t now = GetElapsedMs();
+		mPendingEvents.Advance(now, mExpired);
+
+		if (!mDevices.empty()) {
+			for (const Interrupt& irq : mExpired) {
+				OnDeviceFinished(irq.mDevice, now);
+			}
 		}
 
-		// We have pending events, so wait until that's done, or if a stop is requested
-		auto nextTime = mPendingEvents.top().mWhen;
-		mCv.wait_until(lock, nextTime, [&] { return st.stop_requested() || !mNewBlocks.empty(); });
-		if (st.stop_requested()) {
-			break;
+		// Hold completions back until there's enough of them, or the oldest has waited long enough
+		if (IsCoalescing() && !mExpired.empty()) {
+			if (mCoalesced.empty()) {
+				mCoalesceDeadline = now + cfg::gIrqCoalesceWindow;
+			}
+
+			mCoalesced.insert(mCoalesced.end(), mExpired.begin(), mExpired.end());
+			mExpired.clear();
 		}
 
-		// If your time has come, so be it
-		now = std::chrono::steady_clock::now();
-		while (!mPendingEvents.empty() && mPendingEvents.top().mWhen <= now) {
-			IOEvent top = mPendingEvents.top();
-			mPendingEvents.pop();
+		if (!mCoalesced.empty() && (mCoalesced.size() >= cfg::gIrqCoalesceCount || now >= mCoalesceDeadline)) {
+			mExpired.swap(mCoalesced);
+		}
 
-			ProcessControlBlock* pcb = top.mPcb;
+		// Posting can wait on the CPU if the inbox is full, and the CPU may want 'mMutex' to block something else
+		if (!mExpired.empty()) {
+			lock.unlock();
+			PostBatch(mExpired);
+			lock.lock();
+			continue;
+		}
 
-			// Consume the I/O burst
-			pcb->mProcess.PopCurrentBurst();
+		// Sleep until the next timer could be due, or something sooner comes along
+		mWakeAt = mPendingEvents.GetNextExpiry();
+		mRearm  = false;
 
-			// If there are any bursts remaining, re-ready it
-			if (pcb->mProcess.GetBurst()) {
-				ThreadPrint("PID[", pcb->mProcessIdentifier, "] - > [UNBLOCKED FROM I/O BURST]");
-				pcb->mState.store(ProcessState::Ready);
-				pcb->mProcess.GetParentCPU()->AddProcess(pcb);
-			} else {
-				ThreadPrint("PID[", pcb->mProcessIdentifier, "] - > [EXIT FROM I/O BURST]");
-				pcb->mState.store(ProcessState::Terminated);
-				pcb->mProcess.GetParentCPU()->TerminateProcess(pcb);
-			}
+		if (!mCoalesced.empty()) {
+			mWakeAt = std::min(mWakeAt, mCoalesceDeadline);
+		}
+
+		if (mWakeAt == TimingWheel<Interrupt>::Never) {
+			mCv.wait(lock, [&] { return st.stop_requested() || mRearm; });
+		} else {
+			mCv.wait_until(lock, mStartTime + std::chrono::milliseconds(mWakeAt), [&] { return st.stop_requested() || mRearm; });
 		}
 	}
 }
@@ -2,42 +2,150 @@
 #define _INTERRUPTCONTROLLER_HPP
 
 #include <condition_variable>
+#include <unordered_map>
+#include <deque>
 #include <thread>
 #include <vector>
+#include <memory>
 #include <mutex>
-#include <queue>
 
+#include "TimingWheel.hpp"
+#include "MpscQueue.hpp"
+#include "io/IODevice.hpp"
 #include "util.hpp"
 
 class CPU;
 struct ProcessControlBlock;
 
-struct IOEvent {
-	std::chrono::steady_clock::time_point mWhen;
+// A finished I/O burst, posted by the I/O thread for the CPU thread to handle
+struct Interrupt {
 	ProcessControlBlock* mPcb = nullptr;
-	bool operator<(IOEvent const& o) const { return mWhen > o.mWhen; }
+	std::chrono::steady_clock::time_point mDue; // When the I/O was due to complete (real time)
+	std::uint64_t mDueTick = 0;                 // ... (virtual time)
+	std::uint32_t mDevice  = 0;                 // The device that serviced it (if devices are simulated)
+	bool mIsAsync          = false;             // Submitted asynchronously, the process may well still be running
+	bool mIsLast           = true;              // Last completion of a coalesced batch, the CPU takes the interrupt here
 };
 
 class InterruptController {
 public:
 	NON_COPYABLE(InterruptController)
 
-	InterruptController();
+	explicit InterruptController(CPU& parent);
 	~InterruptController();
 
+	// Builds the I/O devices and spins up the I/O thread (real time only, virtual time is driven by the CPU's event queue)
+	void Start();
+
 	void NotifyBlocked(ProcessControlBlock*);
 
+	// [CPU THREAD] Starts the current (asynchronous) I/O burst without blocking the process
+	void SubmitAsync(ProcessControlBlock*);
+
+	// [CPU THREAD] The process reached a wait point, true if nothing is outstanding, otherwise it's woken once everything is
+	bool WaitForAsync(ProcessControlBlock*);
+
+	// [CPU THREAD] How many asynchronous I/O bursts the process has in flight
+	std::uint32_t GetOutstandingIO(const ProcessControlBlock*) const;
+
+	// [CPU THREAD] Drops a pending I/O burst, for a process that's being terminated while blocked
+	void CancelIO(ProcessControlBlock*);
+
+	// [CPU THREAD] Handles every interrupt posted since the last call, returns how many completions there were
+	std::size_t DrainInbox();
+
+	// [CPU THREAD] A virtual time I/O completion fired, it's delivered now or coalesced with others
+	void OnIOExpired(ProcessControlBlock*, std::uint64_t dueTick, std::uint32_t device, bool isAsync);
+
+	// [CPU THREAD] Takes one interrupt for everything coalesced so far
+	void FlushBatch();
+
+	// [CPU THREAD] Consumes the finished I/O burst and re-readies (or terminates) the process
+	void CompleteIO(ProcessControlBlock*, bool isAsync = false);
+
+	// Tracks / prints how long completions took to be handled after they were due
+	void RecordLatency(std::uint64_t latency);
+	void PrintStats() const;
+
 private:
 	void IOWorker(std::stop_token);
+	void PostInterrupt(const Interrupt&);
+	void PostBatch(std::vector<Interrupt>& batch);
+
+	// What a finished I/O burst leaves the process needing
+	enum class Release {
+		Nothing = 0, // Still waiting (on other async I/O), or already gone
+		Ready,       // It has more work, it should be readied
+		Exit,        // That was its last burst, it should be terminated
+	};
+
+	// Consumes the finished I/O burst
+	Release ReleaseFromIO(ProcessControlBlock*, bool isAsync);
+
+	// Queues the current I/O burst on its device (or the ideal device)
+	void SubmitIO(ProcessControlBlock*, bool isAsync);
+
+	static inline bool IsCoalescing() { return cfg::gIrqCoalesceCount > 1; }
+
+	// Starts the completion timer for a burst, in real time 'mMutex' must be held
+	void ArmTimer(ProcessControlBlock*, std::uint64_t when, std::uint32_t device, bool isAsync);
+
+	// Moves as many queued requests into service as the device has room for, in real time 'mMutex' must be held
+	void StartRequests(std::uint32_t device, std::uint64_t now);
+
+	// A request has finished (or been aborted) on a device, letting the next one in
+	void OnDeviceFinished(std::uint32_t device, std::uint64_t now);
+
+	// Real time I/O deadlines are kept in milliseconds since the controller was made
+	std::uint64_t GetElapsedMs() const;
+
+	// The clock devices run on, ticks in virtual time and milliseconds otherwise
+	std::uint64_t GetNow() const;
+
+	CPU& mParent;
 
 	// Synchronisation
 	std::jthread mIoThread;
 	std::mutex mMutex;
 	std::condition_variable mCv;
+	std::uint64_t mWakeAt = TimingWheel<Interrupt>::Never; // When the I/O thread is next going to wake up by itself
+	bool mRearm           = false;                         // Something needs the I/O thread to wake up sooner
 
 	// State
-	std::vector<ProcessControlBlock*> mNewBlocks; // Newly blocked processes that haven't been added to pending events
-	std::priority_queue<IOEvent> mPendingEvents;  // All pending events that are awaiting comp[letion
+	std::chrono::steady_clock::time_point mStartTime;
+	TimingWheel<Interrupt> mPendingEvents; // All pending events that are awaiting completion
+	std::vector<Interrupt> mExpired;       // [I/O THREAD] Completions about to be posted
+	std::vector<Interrupt> mCoalesced;     // [I/O THREAD] Completions held back to be posted as one interrupt
+	std::uint64_t mCoalesceDeadline = 0;   // [I/O THREAD] When the held back completions have to go regardless
+	MpscQueue<Interrupt, 4096> mInbox;     // Completions waiting for the CPU to pick them up at a tick boundary
+
+	// Devices (guarded by 'mMutex' in real time), empty when the ideal device is used
+	std::vector<std::unique_ptr<IODevice>> mDevices;
+
+	// Asynchronous I/O in flight per process (CPU thread only)
+	struct AsyncState {
+		std::deque<std::uint64_t> mSubmitTimes; // One per burst in flight, oldest first
+		std::uint64_t mWaitStart = 0;
+		bool mIsWaiting          = false; // Blocked at a wait point
+	};
+	std::unordered_map<const ProcessControlBlock*, AsyncState> mAsync;
+
+	// Delivery (CPU thread)
+	std::vector<Interrupt> mBatch;              // Completions making up the next interrupt
+	std::vector<ProcessControlBlock*> mReadied; // Scratch list of processes a batch puts back in the ready queue
+	std::vector<ProcessControlBlock*> mExited;  // ... and of those it finishes
+	std::uint64_t mFlushTimer = ~0ull;          // Virtual time event forcing the batch out once the window is up
+
+	// Statistics (microseconds in real time, ticks in virtual time)
+	std::uint64_t mCompletionCount = 0;
+	std::uint64_t mTotalLatency    = 0;
+	std::uint64_t mMaxLatency      = 0;
+	std::uint64_t mInterruptCount  = 0; // Interrupts actually taken by the CPU
+	std::uint64_t mHandlingTicks   = 0; // Total cost of taking them
+	std::uint64_t mAsyncSubmitted  = 0;
+	std::uint64_t mAsyncIoTime     = 0; // Submission to completion, summed over every asynchronous burst that completed
+	std::uint64_t mAsyncBlocked    = 0; // Waits that actually had to block
+	std::uint64_t mAsyncWaitTime   = 0; // ... and how long for
 };
 
 #endif
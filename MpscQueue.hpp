@@ -0,0 +1,88 @@
+#ifndef _MPSCQUEUE_HPP
+#define _MPSCQUEUE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <array>
+
+#include "util.hpp"
+
+// Bounded, lock-free, multi-producer / single-consumer ring buffer
+// Every cell carries a sequence number saying whose turn it is (a producer filling it, or the consumer emptying it),
+// so producers only ever contend on the tail index and the consumer never has to take a lock at all
+template <typename T, std::size_t Capacity>
+class MpscQueue {
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "CAPACITY MUST BE A POWER OF TWO");
+
+public:
+	NON_COPYABLE(MpscQueue)
+
+	MpscQueue()
+	{
+		for (std::size_t i = 0; i < Capacity; ++i) {
+			mCells[i].mSequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	~MpscQueue() = default;
+
+	// Safe from any thread, false if the queue is full
+	bool TryPush(const T& value)
+	{
+		Cell* cell      = nullptr;
+		std::size_t pos = mTail.load(std::memory_order_relaxed);
+
+		while (true) {
+			cell                    = &mCells[pos & (Capacity - 1)];
+			const std::size_t seq   = cell->mSequence.load(std::memory_order_acquire);
+			const std::intptr_t dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+			if (dif == 0) {
+				// Cell is free for this position, try to claim it
+				if (mTail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (dif < 0) {
+				// The consumer hasn't emptied this cell yet
+				return false;
+			} else {
+				// Another producer beat us to it
+				pos = mTail.load(std::memory_order_relaxed);
+			}
+		}
+
+		cell->mValue = value;
+		cell->mSequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer thread only, false if the queue is empty
+	bool TryPop(T& out)
+	{
+		Cell& cell            = mCells[mHead & (Capacity - 1)];
+		const std::size_t seq = cell.mSequence.load(std::memory_order_acquire);
+
+		if (static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(mHead + 1) < 0) {
+			return false;
+		}
+
+		out = cell.mValue;
+		cell.mSequence.store(mHead + Capacity, std::memory_order_release);
+		mHead++;
+		return true;
+	}
+
+private:
+	struct Cell {
+		std::atomic<std::size_t> mSequence;
+		T mValue;
+	};
+
+	// Kept on separate cache lines so producers and the consumer don't false share
+	alignas(64) std::array<Cell, Capacity> mCells;
+	alignas(64) std::atomic<std::size_t> mTail = 0;
+	alignas(64) std::size_t mHead              = 0;
+};
+
+#endif
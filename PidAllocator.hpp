@@ -0,0 +1,102 @@
+#ifndef _PIDALLOCATOR_HPP
+#define _PIDALLOCATOR_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <limits>
+#include <bit>
+
+#include "util.hpp"
+
+// Hands out the lowest PID not in use, O(log64 n) allocation and release
+// - A bit per PID on the bottom level (set - in use), every level above has a bit per word of the one below, set once that word is full
+// - Finding the lowest free PID walks from the single top word down, taking the first clear bit on every level
+// - Once the top word is full another level goes on top, every level below growing 64 times over (so capacity is always 64^levels)
+class PidAllocator {
+public:
+	NON_COPYABLE(PidAllocator)
+
+	PidAllocator()
+	    : mLevels(1, std::vector<std::uint64_t>(1, 0))
+	{
+	}
+
+	~PidAllocator() = default;
+
+	std::uint32_t Allocate()
+	{
+		if (mLevels.back().front() == Full) {
+			Grow();
+		}
+
+		std::size_t pid = 0;
+		for (std::size_t level = mLevels.size(); level-- > 0;) {
+			pid = pid * WordBits + std::countr_one(mLevels[level][pid]);
+		}
+
+		REQUIRE(pid <= std::numeric_limits<std::uint32_t>::max());
+
+		// Mark it, and every word above that it just filled up
+		std::size_t index = pid;
+		for (std::vector<std::uint64_t>& words : mLevels) {
+			std::uint64_t& word = words[index / WordBits];
+			word |= std::uint64_t(1) << (index % WordBits);
+			if (word != Full) {
+				break;
+			}
+
+			index /= WordBits;
+		}
+
+		mLiveCount++;
+		return static_cast<std::uint32_t>(pid);
+	}
+
+	void Release(std::uint32_t pid)
+	{
+		REQUIRE(IsUsed(pid));
+
+		// Unmark it, and every word above that was only marked because this one was full
+		std::size_t index = pid;
+		for (std::vector<std::uint64_t>& words : mLevels) {
+			std::uint64_t& word = words[index / WordBits];
+			const bool wasFull  = word == Full;
+			word &= ~(std::uint64_t(1) << (index % WordBits));
+			if (!wasFull) {
+				break;
+			}
+
+			index /= WordBits;
+		}
+
+		mLiveCount--;
+	}
+
+	inline bool IsUsed(std::uint32_t pid) const
+	{
+		const std::vector<std::uint64_t>& bottom = mLevels.front();
+		return pid / WordBits < bottom.size() && (bottom[pid / WordBits] >> (pid % WordBits)) & 1;
+	}
+
+	inline std::size_t GetLiveCount() const { return mLiveCount; }
+
+private:
+	static constexpr std::size_t WordBits = 64;
+	static constexpr std::uint64_t Full   = ~std::uint64_t(0);
+
+	void Grow()
+	{
+		// The old top word becomes the new one's first (full) child, the rest of the new space is free
+		for (std::vector<std::uint64_t>& words : mLevels) {
+			words.resize(words.size() * WordBits, 0);
+		}
+
+		mLevels.push_back({ 1 });
+	}
+
+	std::vector<std::vector<std::uint64_t>> mLevels; // Bottom (a bit per PID) first
+	std::size_t mLiveCount = 0;
+};
+
+#endif
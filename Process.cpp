@@ -4,51 +4,108 @@
 #include "Process.hpp"
 #include "CPU.hpp"
 #include "rng.hpp"
+#include "io/IODevice.hpp"
 
-Process::Process(std::size_t bursts, CPU* parent, ProcessControlBlock* parentBlock)
-    : mParentCpu(parent)
-    , mParentBlock(parentBlock)
+BurstStream::BurstStream(std::uint32_t seed, std::size_t bursts)
+    : mEngine(seed)
+    , mBurstsLeft(static_cast<std::uint32_t>(bursts))
 {
-	// Populate our work buffer
-	std::bernoulli_distribution coin(0.7f); // 70% - CPU, 30% - IO
-	std::uniform_int_distribution<std::uint32_t> cpuDurationRange(100, 2500);
-	std::uniform_int_distribution<std::uint32_t> ioDurationRange(1000, 7500);
-
-	for (std::size_t i = 0; i < bursts; ++i) {
-		if (coin(rng::GetRandomEngine())) {
-			mWork.push({ ProcessWork::Type::CPU, cpuDurationRange(rng::GetRandomEngine()) });
-		} else {
-			mWork.push({ ProcessWork::Type::IO, ioDurationRange(rng::GetRandomEngine()) });
+}
+
+bool BurstStream::Next(ProcessWork& burst)
+{
+	// Asynchronous I/O overlaps with the next CPU burst, and is waited on straight after
+	if (mIsWaitDue) {
+		burst      = { ProcessWork::Type::Wait, 0 };
+		mIsWaitDue = false;
+		return true;
+	}
+
+	if (!mBurstsLeft) {
+		// Never leave with I/O still in flight
+		if (mIsWaitPending) {
+			burst          = { ProcessWork::Type::Wait, 0 };
+			mIsWaitPending = false;
+			return true;
 		}
+
+		return false;
+	}
+
+	mBurstsLeft--;
+
+	std::bernoulli_distribution coin(0.7f); // 70% - CPU, 30% - IO
+	if (coin(mEngine)) {
+		burst          = { ProcessWork::Type::CPU, std::uniform_int_distribution<std::uint32_t>(100, 2500)(mEngine) };
+		mIsWaitDue     = mIsWaitPending;
+		mIsWaitPending = false;
+		return true;
+	}
+
+	burst = { ProcessWork::Type::IO, std::uniform_int_distribution<std::uint32_t>(1000, 7500)(mEngine) };
+
+	// Only spread over devices when they're being simulated, the ideal device has nowhere to put it
+	if (cfg::gIoDeviceCount) {
+		burst.mDevice = std::uniform_int_distribution<std::uint32_t>(0, cfg::gIoDeviceCount - 1)(mEngine);
+		burst.mTrack  = std::uniform_int_distribution<std::uint32_t>(0, IODevice::TrackCount - 1)(mEngine);
+	}
+
+	if (cfg::gAsyncIoChance && std::bernoulli_distribution(cfg::gAsyncIoChance / 100.0f)(mEngine)) {
+		burst.mIsAsync = true;
+		mIsWaitPending = true;
 	}
 
-	mPredictedBurstLength = mPreviousPredictedLength = static_cast<float_t>(cfg::gInitialBurstPrediction);
+	return true;
+}
+
+Process::Process(std::size_t bursts, CPU* parent, ProcessControlBlock* parentBlock)
+    : mPredictor(MakeBurstPredictor(static_cast<BurstPredictorType>(cfg::gBurstPredictor)))
+    , mBursts(static_cast<std::uint32_t>(rng::GetRandomEngine()()), bursts)
+    , mParentCpu(parent)
+    , mParentBlock(parentBlock)
+{
+	// How tight this process' deadlines are, every CPU burst being due this many percent of its length after it's released
+	const std::uint32_t slackLimit = std::max<std::uint32_t>(cfg::gDeadlineSlack, MinimumDeadlineSlack);
+	mParentBlock->mDeadlineSlack   = std::uniform_int_distribution<std::uint32_t>(MinimumDeadlineSlack, slackLimit)(rng::GetRandomEngine());
+
+	NextBurst();
+	RefreshPrediction();
+	ReleaseBurst();
 }
 
 bool Process::Step()
 {
 	// We're out of work to do, all done!
-	if (mWork.empty()) {
+	if (IsOutOfWork()) {
 		return true;
 	}
 
 	ProcessWork* burst = GetBurst();
 	if (burst->Step()) {
-		// If the burst is complete, pop it and keep going
-		UpdatePredictedBurst();
+		// The real length is known now, see how the prediction did and learn from it
+		const std::uint32_t duration = burst->mDuration;
+		mParentCpu->GetPredictionStats().Record(mParentBlock->mPredictedBurst, static_cast<float_t>(duration));
+		mPredictor->OnBurstComplete(static_cast<float_t>(duration));
+		mParentCpu->GetScheduler()->OnBurstComplete(mParentBlock, duration);
+
+		// ... and whether it made its deadline
+		if (mParentBlock->mDeadline) {
+			mParentCpu->GetDeadlineStats().Record(mParentBlock->mDeadline, mParentCpu->GetTick());
+		}
 
-		mWork.pop();
+		// If the burst is complete, pop it and keep going
+		PopCurrentBurst();
 
 		// We're out of work to do, all done!
-		if (mWork.empty()) {
+		if (IsOutOfWork()) {
 			return true;
 		}
 
 		std::stringstream ss;
-		ss << "[" << mParentBlock->mProcessIdentifier << "] - > SPENT [" << burst->mDuration << " ticks] IN WORK";
+		ss << "[" << mParentBlock->mProcessIdentifier << "] - > SPENT [" << duration << " ticks] IN WORK";
 
 		// Only show predicted burst length if contextually relevant (SRTF / SJF)
-		auto algorithm = mParentCpu->GetScheduler()->GetAlgorithm();
+		auto algorithm = mParentCpu->GetAlgorithm();
 		if (algorithm == SchedulingAlgorithm::SJF || algorithm == SchedulingAlgorithm::SRTF) {
 			ss << " ~[" << GetRemainingPredictedBurstLength() << "ms]";
 		}
@@ -59,43 +116,51 @@ bool Process::Step()
 	return false;
 }
 
-void Process::UpdatePredictedBurst()
+void Process::RefreshPrediction()
 {
-	// If non-existent, hasn't progressed at all, or isn't CPU, exit
-	const ProcessWork* burst = GetBurst();
-	if (!burst || !burst->mProgress || burst->mType != ProcessWork::Type::CPU) {
-		return;
-	}
-
-	mPreviousPredictedLength = mPredictedBurstLength;
-	const float_t progress   = static_cast<float_t>(burst->mProgress);
+	const ProcessWork* burst      = GetBurst();
+	mParentBlock->mPredictedBurst = burst ? mPredictor->Predict(*burst) : 0.0f;
+}
 
-	// tau_next = alpha * t_n + (1 - alpha) * tau_n
-	constexpr float_t a   = 0.5f; // [0 -> 1] 1 = recent bursts mean more
-	mPredictedBurstLength = a * progress + (1.0f - a) * mPreviousPredictedLength;
+void Process::NextBurst()
+{
+	mIsOutOfWork = !mBursts.Next(mBurst);
+	if (!mIsOutOfWork && mBurst.mType == ProcessWork::Type::CPU) {
+		mBurst.mDeadline = static_cast<std::uint32_t>(std::uint64_t(mBurst.mDuration) * mParentBlock->mDeadlineSlack / 100);
+	}
 }
 
 void Process::PopCurrentBurst()
 {
-	if (!mWork.empty()) {
-		mWork.pop();
+	if (!IsOutOfWork()) {
+		NextBurst();
+		RefreshPrediction();
+		ReleaseBurst();
 	}
 }
 
-ProcessWork* Process::GetBurst() { return mWork.empty() ? nullptr : &mWork.front(); }
+void Process::ReleaseBurst()
+{
+	const ProcessWork* burst = GetBurst();
+	if (!burst || burst->mType != ProcessWork::Type::CPU || !burst->mDeadline) {
+		mParentBlock->mDeadline = 0;
+		return;
+	}
 
-const std::queue<ProcessWork>& Process::GetWorkQueue() const { return mWork; }
+	mParentBlock->mDeadline = mParentCpu->GetTick() + burst->mDeadline;
+}
 
-float_t Process::GetRemainingPredictedBurstLength()
-{
-	ProcessWork* burst = GetBurst();
+ProcessWork* Process::GetBurst() { return IsOutOfWork() ? nullptr : &mBurst; }
+
+float_t Process::GetPredictedBurstLength() const { return mParentBlock->mPredictedBurst; }
 
-	if (!burst || burst->mType != ProcessWork::Type::CPU) {
+float_t Process::GetRemainingPredictedBurstLength() const
+{
+	if (IsOutOfWork() || mBurst.mType != ProcessWork::Type::CPU) {
 		return 0.0f;
 	}
 
-	UpdatePredictedBurst();
-	return std::max(0.0f, mPredictedBurstLength - static_cast<float_t>(burst->mProgress));
+	return std::max(0.0f, mParentBlock->mPredictedBurst - static_cast<float_t>(mBurst.mProgress));
 }
 
 ProcessControlBlock::ProcessControlBlock(CPU* parentCpu)
@@ -103,8 +168,13 @@ ProcessControlBlock::ProcessControlBlock(CPU* parentCpu)
 {
 	mState.store(ProcessState::Created);
 
-	if (parentCpu->GetScheduler()->GetAlgorithm() == SchedulingAlgorithm::Priority) {
-		mPriority     = static_cast<std::uint16_t>(rng::GetUniformRandomNumber(rng::RandomIntRange(0, 10)));
+	// Always drawn, so a given seed makes the same processes whichever algorithm runs them
+	const std::uint32_t priority = static_cast<std::uint16_t>(rng::GetUniformRandomNumber(rng::RandomIntRange(0, 10)));
+
+	// Fair scheduling turns the priority into a share of the CPU
+	const SchedulingAlgorithm algo = parentCpu->GetAlgorithm();
+	if (algo == SchedulingAlgorithm::Priority || algo == SchedulingAlgorithm::Fair) {
+		mPriority     = priority;
 		mBasePriority = mPriority;
 	} else {
 		mBasePriority = mPriority = 0;
@@ -2,8 +2,10 @@
 #define _PROCESS_HPP
 
 #include <optional>
-#include <queue>
+#include <memory>
+#include <random>
 #include "util.hpp"
+#include "predict/IBurstPredictor.hpp"
 
 class CPU;
 struct ProcessControlBlock;
@@ -13,6 +15,7 @@ struct ProcessWork {
 	enum class Type {
 		CPU = 0,
 		IO,
+		Wait, // Blocks until every asynchronous I/O burst submitted before it has completed
 	};
 
 	ProcessWork(Type t, std::uint32_t d)
@@ -24,12 +27,42 @@ struct ProcessWork {
 	// True if complete, false if not
 	inline bool Step() { return ++mProgress == mDuration; }
 	inline bool IsComplete() const noexcept { return mProgress == mDuration; }
+	inline std::uint32_t GetRemaining() const noexcept { return mDuration - mProgress; }
 
-	inline const char* GetTypeString() const { return mType == Type::CPU ? "CPU" : "I/O"; }
+	// Skips 'ticks' worth of progress at once, must not complete the burst
+	inline void Advance(std::uint32_t ticks) { mProgress += ticks; }
+
+	inline const char* GetTypeString() const { return mType == Type::CPU ? "CPU" : mType == Type::IO ? "I/O" : "WAIT"; }
 
 	Type mType              = Type::CPU;
 	std::uint32_t mDuration = 0;
 	std::uint32_t mProgress = 0;
+
+	// I/O only, which device the burst is for and where on it
+	std::uint32_t mDevice = 0;
+	std::uint32_t mTrack  = 0;
+	bool mIsAsync         = false; // The process carries on running while it's serviced
+
+	// CPU only, how long after it's released the burst should be done by (0 - no deadline)
+	std::uint32_t mDeadline = 0;
+};
+
+// Produces a process' bursts one at a time, as it gets to them, so a process only ever holds the one it's on
+// - Has its own engine seeded per process, so the same seed always gives the same bursts whatever else draws in between
+// - Deadlines are left to the process, every burst comes out with none
+class BurstStream {
+public:
+	BurstStream(std::uint32_t seed, std::size_t bursts);
+	BurstStream() = delete;
+
+	// Writes the next burst over 'burst', false (leaving it as it was) once there are none left
+	bool Next(ProcessWork& burst);
+
+private:
+	std::default_random_engine mEngine;
+	std::uint32_t mBurstsLeft = 0;     // CPU / I/O bursts still to draw, waits aren't counted
+	bool mIsWaitPending       = false; // An asynchronous burst has been submitted that nothing waits on yet
+	bool mIsWaitDue           = false; // ... and a CPU burst has overlapped it, so the wait comes next
 };
 
 // A process / thread is really just a list of 'work' for the CPU to complete
@@ -37,6 +70,9 @@ class Process {
 public:
 	NON_COPYABLE(Process)
 
+	// Deadlines are never tighter than this percentage of a burst's length, so any one process alone is schedulable
+	static constexpr std::uint32_t MinimumDeadlineSlack = 150;
+
 	Process(std::size_t bursts, CPU* parent, ProcessControlBlock* parentBlock);
 	Process() = delete;
 
@@ -44,21 +80,35 @@ public:
 
 	bool Step();
 
-	void UpdatePredictedBurst();
+	// Moves on to the next burst, re-predicting it and starting its deadline
 	void PopCurrentBurst();
+
+	// (Re)starts the front burst's deadline from the current tick
+	void ReleaseBurst();
 	ProcessWork* GetBurst();
-	inline const std::queue<ProcessWork>& GetWorkQueue() const;
 
-	inline float_t GetPredictedBurstLength() const { return mPredictedBurstLength; }
-	float_t GetRemainingPredictedBurstLength();
+	// Both read the prediction cached on the PCB, they never change it
+	float_t GetPredictedBurstLength() const;
+	float_t GetRemainingPredictedBurstLength() const;
 
 	inline CPU* GetParentCPU() { return mParentCpu; }
 
 private:
-	float_t mPredictedBurstLength    = 0.0f;
-	float_t mPreviousPredictedLength = 0.0f;
+	// Caches the predictor's guess for the front burst on the PCB, only on a burst event (a new front burst)
+	void RefreshPrediction();
+
+	// Pulls the next burst from the stream into 'mBurst', giving CPU bursts this process' deadline
+	void NextBurst();
+
+	inline bool IsOutOfWork() const { return mIsOutOfWork; }
+
+	std::unique_ptr<IBurstPredictor> mPredictor;
+
+	// Only the burst being worked on is kept, the rest are made as it completes
+	BurstStream mBursts;
+	ProcessWork mBurst { ProcessWork::Type::CPU, 0 };
+	bool mIsOutOfWork = false;
 
-	std::queue<ProcessWork> mWork;
 	CPU* mParentCpu                   = nullptr;
 	ProcessControlBlock* mParentBlock = nullptr;
 };
@@ -100,9 +150,25 @@ struct ProcessControlBlock {
 	std::uint32_t mProcessIdentifier = 0;                     // PID
 
 	// Priority
-	std::uint32_t mBasePriority          = 0; // The original priority
-	std::uint32_t mPriority              = 0;
-	std::uint64_t mInactivePriorityTimer = 0; // For bumping priority after time
+	std::uint32_t mBasePriority = 0; // The original priority
+	std::uint32_t mPriority     = 0; // Bumped by aging while it waits (see 'CPU::HandlePriorityAging')
+
+	// I/O
+	std::uint64_t mIoTimer = ~0ull; // Handle to the pending I/O completion, owned by the InterruptController
+
+	// Deadlines
+	std::uint64_t mDeadline      = 0; // Absolute tick the current CPU burst is due by (0 - none), set by 'mProcess' on burst events
+	std::uint32_t mDeadlineSlack = 0; // Every CPU burst's relative deadline, as a percentage of its length
+
+	// Groups (see 'GroupScheduler')
+	std::uint32_t mGroup      = 0; // Which group it belongs to, set before it's added to the CPU
+	std::uint64_t mReadySince = 0; // Tick it last became ready
+
+	// Scheduling keys
+	float_t mPredictedBurst       = 0.0f; // Predicted length of the current (or next) CPU burst, set by 'mProcess' on burst events
+	std::uint32_t mQueueLevel     = 0;    // MLFQ only, the level it's queued on (0 - top)
+	std::uint64_t mVirtualRuntime = 0;    // Fair only, weighted CPU time received so far (see 'FairScheduler')
+	std::uint32_t mSliceProgress  = 0;    // RR only, how far into its CPU burst it was when its current slice began
 
 	// Process
 	std::uint32_t mProgramCounter = 0; // How many 'instructions' have been executed
@@ -0,0 +1,184 @@
+#include "ProcessTable.hpp"
+
+#include <algorithm>
+
+#if defined(__AVX2__)
+#define INEVITABLE_TABLE_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define INEVITABLE_TABLE_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(INEVITABLE_TABLE_AVX2) || defined(INEVITABLE_TABLE_SSE2)
+static_assert(sizeof(float_t) == sizeof(float), "THE KERNELS WORK ON SINGLE PRECISION LANES");
+#endif
+
+void ProcessTable::Reserve(std::uint32_t pid)
+{
+	if (pid < mPriority.size()) {
+		return;
+	}
+
+	// Doubling, so PIDs handed out one after another grow it in amortised O(1)
+	const std::size_t rows = std::max<std::size_t>((pid / RowAlignment + 1) * RowAlignment, mPriority.size() * 2);
+	mPriority.resize(rows, NoPriority);
+	mIsReady.resize(rows, 0);
+	mRemaining.resize(rows, NoRemaining);
+	mReadySince.resize(rows, NoReadySince);
+}
+
+void ProcessTable::SetReady(std::uint32_t pid, std::uint32_t priority, float_t remaining, std::uint64_t tick)
+{
+	Reserve(pid);
+	if (!mIsReady[pid]) {
+		mIsReady[pid] = 1;
+		mReadyCount++;
+	}
+
+	mPriority[pid]   = priority;
+	mRemaining[pid]  = remaining;
+	mReadySince[pid] = tick;
+}
+
+void ProcessTable::ClearReady(std::uint32_t pid)
+{
+	if (pid >= mIsReady.size() || !mIsReady[pid]) {
+		return;
+	}
+
+	mIsReady[pid] = 0;
+	mReadyCount--;
+
+	mPriority[pid]   = NoPriority;
+	mRemaining[pid]  = NoRemaining;
+	mReadySince[pid] = NoReadySince;
+}
+
+void ProcessTable::SetPriority(std::uint32_t pid, std::uint32_t priority)
+{
+	if (pid < mIsReady.size() && mIsReady[pid]) {
+		mPriority[pid] = priority;
+	}
+}
+
+std::uint32_t ProcessTable::GetMaxReadyPriority() const
+{
+	const std::size_t rows = mPriority.size();
+	std::uint32_t best     = NoPriority;
+	std::size_t i          = 0;
+
+#if defined(INEVITABLE_TABLE_AVX2)
+	__m256i bestLanes = _mm256_setzero_si256();
+	for (; i < rows; i += 8) {
+		bestLanes = _mm256_max_epu32(bestLanes, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&mPriority[i])));
+	}
+
+	alignas(32) std::uint32_t lanes[8];
+	_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), bestLanes);
+	best = *std::max_element(std::begin(lanes), std::end(lanes));
+#elif defined(INEVITABLE_TABLE_SSE2)
+	// No unsigned 32 bit max before SSE4.1, flipping the sign bit makes a signed comparison order them the same way
+	const __m128i bias = _mm_set1_epi32(static_cast<std::int32_t>(0x80000000u));
+	__m128i bestLanes  = bias;
+	for (; i < rows; i += 4) {
+		const __m128i biased  = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&mPriority[i])), bias);
+		const __m128i greater = _mm_cmpgt_epi32(biased, bestLanes);
+		bestLanes             = _mm_or_si128(_mm_and_si128(greater, biased), _mm_andnot_si128(greater, bestLanes));
+	}
+
+	alignas(16) std::uint32_t lanes[4];
+	_mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_xor_si128(bestLanes, bias));
+	best = *std::max_element(std::begin(lanes), std::end(lanes));
+#endif
+
+	for (; i < rows; ++i) {
+		best = std::max(best, mPriority[i]);
+	}
+
+	return best;
+}
+
+float_t ProcessTable::GetMinReadyRemaining() const
+{
+	const std::size_t rows = mRemaining.size();
+	float_t best           = NoRemaining;
+	std::size_t i          = 0;
+
+#if defined(INEVITABLE_TABLE_AVX2)
+	__m256 bestLanes = _mm256_set1_ps(NoRemaining);
+	for (; i < rows; i += 8) {
+		bestLanes = _mm256_min_ps(bestLanes, _mm256_loadu_ps(&mRemaining[i]));
+	}
+
+	alignas(32) float_t lanes[8];
+	_mm256_store_ps(lanes, bestLanes);
+	best = *std::min_element(std::begin(lanes), std::end(lanes));
+#elif defined(INEVITABLE_TABLE_SSE2)
+	__m128 bestLanes = _mm_set1_ps(NoRemaining);
+	for (; i < rows; i += 4) {
+		bestLanes = _mm_min_ps(bestLanes, _mm_loadu_ps(&mRemaining[i]));
+	}
+
+	alignas(16) float_t lanes[4];
+	_mm_store_ps(lanes, bestLanes);
+	best = *std::min_element(std::begin(lanes), std::end(lanes));
+#endif
+
+	for (; i < rows; ++i) {
+		best = std::min(best, mRemaining[i]);
+	}
+
+	return best;
+}
+
+std::uint64_t ProcessTable::GetOldestReadySince() const
+{
+	const std::size_t rows = mReadySince.size();
+	std::uint64_t best     = NoReadySince;
+	std::size_t i          = 0;
+
+	// Several accumulators, so one's compare and select overlap with the next's
+	// (there's no 64 bit comparison before SSE4.2, so without AVX2 they're plain integers)
+#if defined(INEVITABLE_TABLE_AVX2)
+	__m256i first  = _mm256_set1_epi64x(static_cast<std::int64_t>(NoReadySince));
+	__m256i second = first;
+	for (; i < rows; i += 8) {
+		const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&mReadySince[i]));
+		const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&mReadySince[i + 4]));
+		first           = _mm256_blendv_epi8(first, a, _mm256_cmpgt_epi64(first, a));
+		second          = _mm256_blendv_epi8(second, b, _mm256_cmpgt_epi64(second, b));
+	}
+
+	alignas(32) std::uint64_t lanes[8];
+	_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), first);
+	_mm256_store_si256(reinterpret_cast<__m256i*>(lanes + 4), second);
+	best = *std::min_element(std::begin(lanes), std::end(lanes));
+#else
+	std::uint64_t lanes[4] = { NoReadySince, NoReadySince, NoReadySince, NoReadySince };
+	for (; i < rows; i += 4) {
+		for (std::size_t lane = 0; lane < 4; ++lane) {
+			lanes[lane] = std::min(lanes[lane], mReadySince[i + lane]);
+		}
+	}
+
+	best = *std::min_element(std::begin(lanes), std::end(lanes));
+#endif
+
+	for (; i < rows; ++i) {
+		best = std::min(best, mReadySince[i]);
+	}
+
+	return best;
+}
+
+const char* ProcessTable::GetKernelName()
+{
+#if defined(INEVITABLE_TABLE_AVX2)
+	return "AVX2";
+#elif defined(INEVITABLE_TABLE_SSE2)
+	return "SSE2";
+#else
+	return "SCALAR";
+#endif
+}
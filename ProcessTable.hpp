@@ -0,0 +1,62 @@
+#ifndef _PROCESSTABLE_HPP
+#define _PROCESSTABLE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "util.hpp"
+
+// The few PCB fields scheduling scans look at, as a structure of arrays with a row per PID (PIDs are dense, see 'PidAllocator')
+// - Kept by the CPU, whose every move into or out of the ready queue (and priority change while there) updates a row
+// - A row that isn't ready holds values no scan can pick over a ready one (lowest priority, nothing remaining, never ready),
+//   so moving in and out is O(1) and the scans are plain reductions over a column, with nothing to mask
+// - Scans are vectorised: AVX2 when built with it (INEVITABLE_ENABLE_AVX2), SSE2 otherwise on x86-64 and plain loops anywhere else
+class ProcessTable {
+public:
+	NON_COPYABLE(ProcessTable)
+
+	// What a row that isn't ready holds, and so what the scans return with nothing ready
+	static constexpr std::uint32_t NoPriority   = 0;
+	static constexpr float_t NoRemaining        = std::numeric_limits<float_t>::infinity();
+	static constexpr std::uint64_t NoReadySince = std::numeric_limits<std::int64_t>::max();
+
+	ProcessTable()  = default;
+	~ProcessTable() = default;
+
+	void SetReady(std::uint32_t pid, std::uint32_t priority, float_t remaining, std::uint64_t tick);
+	void ClearReady(std::uint32_t pid);
+
+	// Ignored unless the process is ready, it's picked up again by SetReady() otherwise
+	void SetPriority(std::uint32_t pid, std::uint32_t priority);
+
+	// Highest priority of any ready process
+	std::uint32_t GetMaxReadyPriority() const;
+
+	// Shortest predicted remaining CPU burst of any ready process
+	float_t GetMinReadyRemaining() const;
+
+	// Tick the longest waiting ready process has been ready since
+	std::uint64_t GetOldestReadySince() const;
+
+	inline std::size_t GetReadyCount() const { return mReadyCount; }
+	inline std::size_t GetRowCount() const { return mPriority.size(); }
+
+	// Which set of kernels the scans were built with
+	static const char* GetKernelName();
+
+private:
+	// Rows come in whole vectors, so the kernels never have a tail to deal with
+	static constexpr std::size_t RowAlignment = 8;
+
+	void Reserve(std::uint32_t pid);
+
+	std::vector<std::uint32_t> mPriority;
+	std::vector<std::uint8_t> mIsReady;     // 1 - ready, 0 - anything else (the state column, the scans never need it)
+	std::vector<float_t> mRemaining;        // Predicted remaining length of the front CPU burst
+	std::vector<std::uint64_t> mReadySince; // Tick it became ready on (fits in 63 bits, the kernels compare it signed)
+	std::size_t mReadyCount = 0;
+};
+
+#endif
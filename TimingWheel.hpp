@@ -0,0 +1,211 @@
+#ifndef _TIMINGWHEEL_HPP
+#define _TIMINGWHEEL_HPP
+
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <limits>
+#include <bit>
+
+#include "util.hpp"
+
+// Hierarchical timing wheel, O(1) insert / cancel and batched expiry of every timer sharing a slot
+// - Each level has 64 slots, a slot on level 'k' covering 64^k ticks
+// - A timer sits on the level of the highest 6-bit digit in which its deadline differs from the current time
+// - When time reaches a slot on a higher level, its timers are cascaded down until they land on level 0 and expire
+// Timers with the same deadline expire in the order they were inserted
+template <typename T>
+class TimingWheel {
+public:
+	NON_COPYABLE(TimingWheel)
+
+	using Handle                          = std::uint64_t;
+	static constexpr Handle InvalidHandle = std::numeric_limits<Handle>::max();
+	static constexpr std::uint64_t Never  = std::numeric_limits<std::uint64_t>::max();
+
+	TimingWheel() { mOccupied.fill(0); }
+	~TimingWheel() = default;
+
+	// Deadlines in the past are clamped to the current time, and expire on the next Advance()
+	Handle Insert(std::uint64_t when, const T& value)
+	{
+		const std::uint32_t index = Allocate();
+		Node& node                = mNodes[index];
+		node.mValue               = value;
+		node.mIsLive              = true;
+
+		Link({ std::max(when, mNow), index, node.mGeneration });
+		mSize++;
+		return (static_cast<Handle>(node.mGeneration) << 32) | index;
+	}
+
+	// False if the timer has already expired (or been cancelled)
+	// The slot entry is left behind and skipped once reached, so cancelling never has to search a slot
+	bool Cancel(Handle handle)
+	{
+		const std::uint32_t index = static_cast<std::uint32_t>(handle);
+		if (handle == InvalidHandle || index >= mNodes.size()) {
+			return false;
+		}
+
+		const Node& node = mNodes[index];
+		if (!node.mIsLive || node.mGeneration != static_cast<std::uint32_t>(handle >> 32)) {
+			return false;
+		}
+
+		Free(index);
+		mSize--;
+		return true;
+	}
+
+	// Moves time forward to 'now', appending every timer that expired on the way to 'expired' (earliest first)
+	void Advance(std::uint64_t now, std::vector<T>& expired)
+	{
+		while (true) {
+			const std::uint64_t next = GetNextExpiry();
+			if (next > now) {
+				// Nothing is due before 'now', so no timer needs to move slots as we jump there
+				mNow = std::max(mNow, now);
+				return;
+			}
+
+			mNow = next;
+
+			// Slots on every level that time has now entered get pushed down (highest first, so they can trickle all the way)
+			for (std::uint32_t level = LevelCount - 1; level > 0; --level) {
+				const std::uint32_t slot = level * SlotCount + GetDigit(mNow, level);
+				if (mSlots[slot].empty()) {
+					continue;
+				}
+
+				DetachSlot(slot);
+				for (const Entry& entry : mScratch) {
+					if (IsCurrent(entry)) {
+						Link(entry);
+					}
+				}
+			}
+
+			// Whatever is in the current level 0 slot is due right now
+			DetachSlot(GetDigit(mNow, 0));
+			for (const Entry& entry : mScratch) {
+				if (IsCurrent(entry)) {
+					expired.push_back(mNodes[entry.mIndex].mValue);
+					Free(entry.mIndex);
+					mSize--;
+				}
+			}
+		}
+	}
+
+	// Earliest tick anything could expire on ('Never' if empty)
+	// Exact for timers on level 0, timers further out report the start of their slot, which is never later than the real deadline
+	std::uint64_t GetNextExpiry() const
+	{
+		for (std::uint32_t level = 0; level < LevelCount; ++level) {
+			if (!mOccupied[level]) {
+				continue;
+			}
+
+			// Level 0 can hold timers due right now, higher levels only ever hold timers beyond the current digit
+			const std::uint32_t digit = GetDigit(mNow, level);
+			const std::uint32_t first = level ? digit + 1 : digit;
+			if (first >= SlotCount) {
+				continue;
+			}
+
+			const std::uint64_t candidates = mOccupied[level] & (~std::uint64_t(0) << first);
+			if (!candidates) {
+				continue;
+			}
+
+			const std::uint32_t shift  = (level + 1) * SlotBits;
+			const std::uint64_t prefix = shift < 64 ? (mNow >> shift) << shift : 0;
+			return prefix | (static_cast<std::uint64_t>(std::countr_zero(candidates)) << (level * SlotBits));
+		}
+
+		return Never;
+	}
+
+	inline std::uint64_t GetTime() const { return mNow; }
+	inline std::size_t GetSize() const { return mSize; }
+	inline bool IsEmpty() const { return mSize == 0; }
+
+private:
+	static constexpr std::uint32_t SlotBits   = 6;
+	static constexpr std::uint32_t SlotCount  = 1 << SlotBits;
+	static constexpr std::uint32_t LevelCount = (64 + SlotBits - 1) / SlotBits; // Enough levels to cover every 64-bit deadline
+
+	// What actually sits in a slot, kept small and contiguous so cascading a slot is a linear walk
+	struct Entry {
+		std::uint64_t mWhen       = 0;
+		std::uint32_t mIndex      = 0;
+		std::uint32_t mGeneration = 0;
+	};
+
+	struct Node {
+		T mValue {};
+		std::uint32_t mGeneration = 0; // Bumped on every free, so stale handles / slot entries are ignored
+		bool mIsLive              = false;
+	};
+
+	static inline std::uint32_t GetDigit(std::uint64_t time, std::uint32_t level)
+	{
+		return static_cast<std::uint32_t>((time >> (level * SlotBits)) & (SlotCount - 1));
+	}
+
+	inline bool IsCurrent(const Entry& entry) const
+	{
+		const Node& node = mNodes[entry.mIndex];
+		return node.mIsLive && node.mGeneration == entry.mGeneration;
+	}
+
+	void Link(const Entry& entry)
+	{
+		const std::uint64_t diff  = entry.mWhen ^ mNow;
+		const std::uint32_t level = diff ? static_cast<std::uint32_t>(63 - std::countl_zero(diff)) / SlotBits : 0;
+		const std::uint32_t digit = GetDigit(entry.mWhen, level);
+
+		mSlots[level * SlotCount + digit].push_back(entry);
+		mOccupied[level] |= std::uint64_t(1) << digit;
+	}
+
+	// Moves a whole slot into 'mScratch' in one go
+	void DetachSlot(std::uint32_t slot)
+	{
+		mScratch.clear();
+		mScratch.swap(mSlots[slot]);
+		mOccupied[slot / SlotCount] &= ~(std::uint64_t(1) << (slot % SlotCount));
+	}
+
+	std::uint32_t Allocate()
+	{
+		if (!mFreeList.empty()) {
+			const std::uint32_t index = mFreeList.back();
+			mFreeList.pop_back();
+			return index;
+		}
+
+		mNodes.emplace_back();
+		return static_cast<std::uint32_t>(mNodes.size() - 1);
+	}
+
+	void Free(std::uint32_t index)
+	{
+		Node& node   = mNodes[index];
+		node.mIsLive = false;
+		node.mGeneration++;
+		mFreeList.push_back(index);
+	}
+
+	std::vector<Node> mNodes;
+	std::vector<std::uint32_t> mFreeList;
+	std::array<std::vector<Entry>, LevelCount * SlotCount> mSlots;
+	std::array<std::uint64_t, LevelCount> mOccupied; // Bitmap of non-empty slots per level
+	std::vector<Entry> mScratch;                     // The slot currently being cascaded / expired
+
+	std::uint64_t mNow = 0;
+	std::size_t mSize  = 0;
+};
+
+#endif
@@ -0,0 +1,103 @@
+#include "EDFScheduler.hpp"
+#include "../Process.hpp"
+
+#include <algorithm>
+
+std::uint64_t EDFScheduler::GetDensity(const ProcessControlBlock* pcb)
+{
+	// Every burst's deadline is the same multiple of its length, so the whole process has a single density
+	return FullDensity * 100 / std::max<std::uint32_t>(pcb->mDeadlineSlack, 100);
+}
+
+Admission EDFScheduler::GetAdmission(const ProcessControlBlock* pcb) const
+{
+	if (!cfg::gEdfAdmission || mAdmittedDensity + GetDensity(pcb) <= FullDensity) {
+		return Admission::Admit;
+	}
+
+	return cfg::gEdfAdmission == 1 ? Admission::Defer : Admission::Reject;
+}
+
+void EDFScheduler::OnNewProcess(ProcessControlBlock* pcb)
+{
+	const LockScope lock = Lock();
+	mFullProcessList.push_back(pcb);
+	mWork.mMoves++;
+	mAdmittedDensity += GetDensity(pcb);
+
+	if (pcb->mState.load() == ProcessState::Ready) {
+		mReadyQueue.Push(pcb, pcb->mDeadline);
+	}
+}
+
+void EDFScheduler::OnReadyProcess(ProcessControlBlock* pcb)
+{
+	const LockScope lock = Lock();
+	mReadyQueue.Push(pcb, pcb->mDeadline);
+}
+
+void EDFScheduler::OnTerminate(ProcessControlBlock* pcb)
+{
+	const LockScope lock = Lock();
+	if (Erase(mFullProcessList, pcb)) {
+		mAdmittedDensity -= GetDensity(pcb);
+	}
+
+	mReadyQueue.Remove(pcb);
+}
+
+void EDFScheduler::OnReadyBatch(std::span<ProcessControlBlock* const> batch)
+{
+	const LockScope lock = Lock();
+	mReadyQueue.PushBatch(batch, [](const ProcessControlBlock* pcb) { return pcb->mDeadline; });
+}
+
+void EDFScheduler::OnTerminateBatch(std::span<ProcessControlBlock* const> batch)
+{
+	const LockScope lock = Lock();
+	EraseBatch(mFullProcessList, batch, [this](ProcessControlBlock* pcb) { mAdmittedDensity -= GetDensity(pcb); });
+	for (ProcessControlBlock* pcb : batch) {
+		mReadyQueue.Remove(pcb);
+	}
+}
+
+bool EDFScheduler::ShouldPreempt(ProcessControlBlock* current, ProcessControlBlock* incoming)
+{
+	// Neither side being about to issue I/O makes a context switch worth it, only an earlier deadline does
+	if (!incoming->mDeadline || !current->mDeadline || incoming->mDeadline >= current->mDeadline) {
+		return false;
+	}
+
+	ThreadPrint("[EDF] PID[", incoming->mProcessIdentifier, "] (DUE ", incoming->mDeadline, ") PREEMPTS PID[", current->mProcessIdentifier,
+	            "] (DUE ", current->mDeadline, ")");
+	return true;
+}
+
+ProcessControlBlock* EDFScheduler::PopNext()
+{
+	const LockScope lock = Lock();
+	return mReadyQueue.IsEmpty() ? nullptr : mReadyQueue.Pop();
+}
+
+ProcessControlBlock* EDFScheduler::PeekNext() { return mReadyQueue.IsEmpty() ? nullptr : mReadyQueue.Top(); }
+
+std::size_t EDFScheduler::PopNextBatch(std::span<ProcessControlBlock*> out)
+{
+	const LockScope lock = Lock();
+	return mReadyQueue.PopBatch(out);
+}
+
+std::size_t EDFScheduler::PeekNextBatch(std::span<ProcessControlBlock*> out) { return mReadyQueue.PeekBatch(out); }
+
+bool EDFScheduler::VisitProcesses(const Visitor& visit) const
+{
+	return std::all_of(mFullProcessList.begin(), mFullProcessList.end(), visit);
+}
+
+bool EDFScheduler::VisitReady(const Visitor& visit) const { return mReadyQueue.VisitValues(visit); }
+
+void EDFScheduler::TakeWork(SchedulerWork& work)
+{
+	mReadyQueue.TakeCounts(mWork.mComparisons, mWork.mMoves);
+	IScheduler::TakeWork(work);
+}
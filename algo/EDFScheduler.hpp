@@ -0,0 +1,57 @@
+#ifndef _EDFSCHEDULER_HPP
+#define _EDFSCHEDULER_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "../IScheduler.hpp"
+#include "../IndexedHeap.hpp"
+#include "../util.hpp"
+
+// Earliest deadline first, every CPU burst carries a deadline and the one due soonest always runs
+// - An arrival due before the running burst preempts it
+// - Admission control keeps the total density (burst length / relative deadline, summed over every process) at or under 1,
+//   the point past which EDF can no longer promise every deadline is met
+// For specific function info see 'IScheduler.hpp'
+class EDFScheduler final : public IScheduler {
+public:
+	// Densities are kept in millionths, so adding and removing processes never drifts
+	static constexpr std::uint64_t FullDensity = 1'000'000;
+
+	virtual ~EDFScheduler() = default;
+
+	ProcessControlBlock* PopNext() override;
+	ProcessControlBlock* PeekNext() override;
+	bool VisitProcesses(const Visitor& visit) const override;
+	bool VisitReady(const Visitor& visit) const override;
+	std::size_t GetProcessCount() const override { return mFullProcessList.size(); }
+	std::size_t GetReadyCount() const override { return mReadyQueue.GetSize(); }
+
+	SchedulingAlgorithm GetAlgorithm() const override { return SchedulingAlgorithm::EDF; }
+
+	void OnNewProcess(ProcessControlBlock*) override;
+	void OnReadyProcess(ProcessControlBlock*) override;
+	void OnTerminate(ProcessControlBlock*) override;
+	void OnPriorityChanged(ProcessControlBlock*) override { }
+	bool ShouldPreempt(ProcessControlBlock* current, ProcessControlBlock* incoming) override;
+
+	void OnReadyBatch(std::span<ProcessControlBlock* const> batch) override;
+	void OnTerminateBatch(std::span<ProcessControlBlock* const> batch) override;
+	std::size_t PopNextBatch(std::span<ProcessControlBlock*> out) override;
+	std::size_t PeekNextBatch(std::span<ProcessControlBlock*> out) override;
+
+	void TakeWork(SchedulerWork& work) override;
+
+	Admission GetAdmission(const ProcessControlBlock*) const override;
+
+private:
+	// How much of the CPU a process needs to make every deadline, in millionths
+	static std::uint64_t GetDensity(const ProcessControlBlock* pcb);
+
+	// Earliest deadline first, processes without one (their front burst isn't CPU work) go straight through, they'll only issue I/O
+	IndexedHeap<ProcessControlBlock*, std::uint64_t> mReadyQueue;
+	std::vector<ProcessControlBlock*> mFullProcessList;
+	std::uint64_t mAdmittedDensity = 0; // Sum of every admitted process' density
+};
+
+#endif
@@ -1,55 +1,88 @@
 #include "FCFSScheduler.hpp"
 #include "../Process.hpp"
 
+#include <algorithm>
+
 void FCFSScheduler::OnNewProcess(ProcessControlBlock* pcb)
 {
-	std::scoped_lock lk(mMutex);
+	const LockScope lock = Lock();
 	mFullProcessList.push_back(pcb);
+	mWork.mMoves++;
 
 	if (pcb->mState.load() == ProcessState::Ready) {
 		mReadyList.push_back(pcb);
+		mWork.mMoves++;
 	}
 }
 
 void FCFSScheduler::OnReadyProcess(ProcessControlBlock* pcb)
 {
-	std::scoped_lock lk(mMutex);
+	const LockScope lock = Lock();
 	mReadyList.push_back(pcb);
+	mWork.mMoves++;
 }
 
 void FCFSScheduler::OnTerminate(ProcessControlBlock* pcb)
 {
-	std::scoped_lock lk(mMutex);
-	std::erase(mFullProcessList, pcb);
-	std::erase(mReadyList, pcb);
+	const LockScope lock = Lock();
+	Erase(mFullProcessList, pcb);
+	Erase(mReadyList, pcb);
+}
+
+void FCFSScheduler::OnReadyBatch(std::span<ProcessControlBlock* const> batch)
+{
+	const LockScope lock = Lock();
+	mReadyList.insert(mReadyList.end(), batch.begin(), batch.end());
+	mWork.mMoves += batch.size();
+}
+
+void FCFSScheduler::OnTerminateBatch(std::span<ProcessControlBlock* const> batch)
+{
+	const LockScope lock = Lock();
+	EraseBatch(mFullProcessList, batch);
+	EraseBatch(mReadyList, batch);
+}
+
+bool FCFSScheduler::ShouldPreempt(ProcessControlBlock*, ProcessControlBlock*)
+{
+	// Non-preemptive, the running process always gets to finish its burst
+	return false;
 }
 
 ProcessControlBlock* FCFSScheduler::PopNext()
 {
-	std::scoped_lock lk(mMutex);
+	const LockScope lock = Lock();
 	if (mReadyList.empty()) {
 		return nullptr;
 	}
 
 	ProcessControlBlock* next = mReadyList.front();
 	mReadyList.pop_front();
+	mWork.mMoves++;
 	return next;
 }
 
-std::vector<ProcessControlBlock*> FCFSScheduler::GetProcessList() const
+ProcessControlBlock* FCFSScheduler::PeekNext() { return mReadyList.empty() ? nullptr : mReadyList.front(); }
+
+std::size_t FCFSScheduler::PopNextBatch(std::span<ProcessControlBlock*> out)
 {
-	std::scoped_lock lk(mMutex);
-	return mFullProcessList;
+	const LockScope lock    = Lock();
+	const std::size_t count = PeekNextBatch(out);
+	mReadyList.erase(mReadyList.begin(), mReadyList.begin() + static_cast<std::ptrdiff_t>(count));
+	mWork.mMoves += count;
+	return count;
 }
 
-std::vector<ProcessControlBlock*> FCFSScheduler::GetReadyList() const
+std::size_t FCFSScheduler::PeekNextBatch(std::span<ProcessControlBlock*> out)
 {
-	std::scoped_lock lk(mMutex);
-	return std::vector<ProcessControlBlock*>(mReadyList.begin(), mReadyList.end());
+	const std::size_t count = std::min(out.size(), mReadyList.size());
+	std::copy_n(mReadyList.begin(), count, out.begin());
+	return count;
 }
 
-bool FCFSScheduler::IsFullProcessListEmpty() const
+bool FCFSScheduler::VisitProcesses(const Visitor& visit) const
 {
-	std::scoped_lock lk(mMutex);
-	return mFullProcessList.empty();
+	return std::all_of(mFullProcessList.begin(), mFullProcessList.end(), visit);
 }
+
+bool FCFSScheduler::VisitReady(const Visitor& visit) const { return std::all_of(mReadyList.begin(), mReadyList.end(), visit); }
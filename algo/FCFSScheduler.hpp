@@ -3,29 +3,37 @@
 
 #include <vector>
 #include <deque>
-#include <mutex>
 
 #include "../IScheduler.hpp"
 #include "../util.hpp"
 
 // For specific function info see 'IScheduler.hpp'
+// NOTE: RR derives from this, so the class can't be final. Its queue is, so calls through an 'FCFSScheduler' are still direct
 class FCFSScheduler : public IScheduler {
 public:
 	virtual ~FCFSScheduler() = default;
 
-	ProcessControlBlock* PopNext() override;
-	std::vector<ProcessControlBlock*> GetProcessList() const override;
-	std::vector<ProcessControlBlock*> GetReadyList() const override;
-	bool IsFullProcessListEmpty() const override;
+	ProcessControlBlock* PopNext() final;
+	ProcessControlBlock* PeekNext() final;
+	bool VisitProcesses(const Visitor& visit) const final;
+	bool VisitReady(const Visitor& visit) const final;
+	std::size_t GetProcessCount() const final { return mFullProcessList.size(); }
+	std::size_t GetReadyCount() const final { return mReadyList.size(); }
 
 	SchedulingAlgorithm GetAlgorithm() const override { return SchedulingAlgorithm::FCFS; }
 
-	void OnNewProcess(ProcessControlBlock*) override;
-	void OnReadyProcess(ProcessControlBlock*) override;
-	void OnTerminate(ProcessControlBlock*) override;
+	void OnNewProcess(ProcessControlBlock*) final;
+	void OnReadyProcess(ProcessControlBlock*) final;
+	void OnTerminate(ProcessControlBlock*) final;
+	void OnPriorityChanged(ProcessControlBlock*) final { }
+	bool ShouldPreempt(ProcessControlBlock* current, ProcessControlBlock* incoming) final;
+
+	void OnReadyBatch(std::span<ProcessControlBlock* const> batch) final;
+	void OnTerminateBatch(std::span<ProcessControlBlock* const> batch) final;
+	std::size_t PopNextBatch(std::span<ProcessControlBlock*> out) final;
+	std::size_t PeekNextBatch(std::span<ProcessControlBlock*> out) final;
 
 private:
-	mutable std::mutex mMutex;
 	std::deque<ProcessControlBlock*> mReadyList;
 	std::vector<ProcessControlBlock*> mFullProcessList;
 };
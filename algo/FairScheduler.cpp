@@ -0,0 +1,273 @@
+#include "FairScheduler.hpp"
+#include "../Process.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <array>
+#include <bit>
+
+namespace {
+	// Linux's nice -> weight table (nice -20 ... 19), each step is roughly 10% more or less CPU
+	constexpr std::array<std::uint64_t, 40> NiceToWeight {
+		88761, 71755, 56483, 46273, 36291, 29154, 23254, 18705, 14949, 11916, 9548, 7620, 6100, 4904, 3906, 3121, 2501, 1991, 1586, 1277,
+		1024,  820,   655,   526,   423,   335,   272,   215,   172,   137,   110,  87,   70,   56,   45,   36,   29,   23,   18,   15,
+	};
+
+	constexpr std::size_t NiceZero = 20;
+} // namespace
+
+std::uint64_t FairScheduler::GetWeight(const ProcessControlBlock* pcb)
+{
+	// Higher priority is more CPU, each level being a nice value below 0
+	return NiceToWeight[NiceZero - std::min<std::size_t>(pcb->mPriority, NiceZero)];
+}
+
+std::uint64_t FairScheduler::GetVruntimeStep(const ProcessControlBlock* pcb)
+{
+	return std::max<std::uint64_t>(VruntimeScale * NiceToWeight[NiceZero] / GetWeight(pcb), 1);
+}
+
+FairScheduler::TimelineKey FairScheduler::MakeKey(ProcessControlBlock* pcb)
+{
+	return { pcb->mVirtualRuntime, pcb->mProcessIdentifier, pcb };
+}
+
+std::uint64_t FairScheduler::GetIdealSlice(const ProcessControlBlock* current) const
+{
+	// The latency target stretches once there are too many processes to give each the minimum granularity
+	const std::uint64_t running = mTimeline.size() + 1;
+	const std::uint64_t period  = std::max<std::uint64_t>(cfg::gFairTargetLatency, running * cfg::gFairMinGranularity);
+
+	const std::uint64_t weight = GetWeight(current);
+	return std::max<std::uint64_t>(period * weight / (mReadyWeight + weight), 1);
+}
+
+std::uint64_t FairScheduler::GetPlacedVruntime(const ProcessControlBlock* pcb) const
+{
+	// Half a latency period of credit for sleeping, no more
+	const std::uint64_t credit = static_cast<std::uint64_t>(cfg::gFairTargetLatency / 2) * VruntimeScale;
+	const std::uint64_t floor  = mMinVruntime > credit ? mMinVruntime - credit : 0;
+	return std::max(pcb->mVirtualRuntime, floor);
+}
+
+void FairScheduler::CountTimelineSearch()
+{
+	// A walk from the root of the tree down to where the key belongs, and the node linked in or out there
+	mWork.mComparisons += std::bit_width(mTimeline.size());
+	mWork.mMoves++;
+}
+
+void FairScheduler::UpdateMinVruntime()
+{
+	// The smallest virtual runtime of everything runnable, never moving backwards
+	std::uint64_t smallest = std::numeric_limits<std::uint64_t>::max();
+	if (mCurrent) {
+		smallest = mCurrent->mVirtualRuntime;
+	}
+
+	if (!mTimeline.empty()) {
+		smallest = std::min(smallest, mTimeline.begin()->mVruntime);
+	}
+
+	if (smallest != std::numeric_limits<std::uint64_t>::max()) {
+		mMinVruntime = std::max(mMinVruntime, smallest);
+	}
+}
+
+void FairScheduler::Enqueue(ProcessControlBlock* pcb)
+{
+	// Re-queued straight off the CPU, it isn't running any more
+	if (pcb == mCurrent) {
+		mCurrent = nullptr;
+	}
+
+	pcb->mVirtualRuntime = GetPlacedVruntime(pcb);
+	mTimeline.insert(MakeKey(pcb));
+	CountTimelineSearch();
+	mReadyWeight += GetWeight(pcb);
+	UpdateMinVruntime();
+}
+
+void FairScheduler::OnNewProcess(ProcessControlBlock* pcb)
+{
+	const LockScope lock = Lock();
+	mFullProcessList.push_back(pcb);
+	mWork.mMoves++;
+
+	// Newcomers start level with everyone else, not with a lifetime of unused CPU
+	pcb->mVirtualRuntime = mMinVruntime;
+	if (pcb->mState.load() == ProcessState::Ready) {
+		Enqueue(pcb);
+	}
+}
+
+void FairScheduler::OnReadyProcess(ProcessControlBlock* pcb)
+{
+	const LockScope lock = Lock();
+	Enqueue(pcb);
+}
+
+void FairScheduler::OnTerminate(ProcessControlBlock* pcb)
+{
+	const LockScope lock = Lock();
+	Erase(mFullProcessList, pcb);
+
+	CountTimelineSearch();
+	if (mTimeline.erase(MakeKey(pcb))) {
+		mReadyWeight -= GetWeight(pcb);
+	}
+
+	if (pcb == mCurrent) {
+		mCurrent = nullptr;
+	}
+}
+
+void FairScheduler::OnTerminateBatch(std::span<ProcessControlBlock* const> batch)
+{
+	const LockScope lock = Lock();
+	EraseBatch(mFullProcessList, batch);
+
+	for (ProcessControlBlock* pcb : batch) {
+		CountTimelineSearch();
+		if (mTimeline.erase(MakeKey(pcb))) {
+			mReadyWeight -= GetWeight(pcb);
+		}
+
+		if (pcb == mCurrent) {
+			mCurrent = nullptr;
+		}
+	}
+}
+
+void FairScheduler::OnBlocked(ProcessControlBlock* pcb)
+{
+	if (pcb == mCurrent) {
+		mCurrent = nullptr;
+	}
+}
+
+bool FairScheduler::ShouldPreempt(ProcessControlBlock* current, ProcessControlBlock* incoming)
+{
+	// Wakeup preemption, only worth a context switch if the newcomer is at least a granularity (in its own terms) behind
+	const std::uint64_t incomingVruntime = GetPlacedVruntime(incoming);
+	const std::uint64_t granularity      = static_cast<std::uint64_t>(cfg::gFairMinGranularity) * GetVruntimeStep(incoming);
+	if (current->mVirtualRuntime <= incomingVruntime || current->mVirtualRuntime - incomingVruntime <= granularity) {
+		return false;
+	}
+
+	ThreadPrint("[FAIR] PID[", incoming->mProcessIdentifier, "] (VRUNTIME ", incomingVruntime / VruntimeScale, ") PREEMPTS PID[",
+	            current->mProcessIdentifier, "] (VRUNTIME ", current->mVirtualRuntime / VruntimeScale, ") ON WAKEUP");
+	return true;
+}
+
+void FairScheduler::OnRunning(ProcessControlBlock* current, std::uint64_t ticks)
+{
+	// Just picked (possibly by a wakeup preemption, which never goes through PopNext()), so it starts a fresh slice
+	if (current != mCurrent) {
+		mCurrent                 = current;
+		mCurrentRun              = 0;
+		current->mVirtualRuntime = GetPlacedVruntime(current);
+	}
+
+	current->mVirtualRuntime += ticks * GetVruntimeStep(current);
+	mCurrentRun += ticks;
+	UpdateMinVruntime();
+}
+
+bool FairScheduler::ShouldPreemptNow(ProcessControlBlock* current)
+{
+	if (mTimeline.empty()) {
+		return false;
+	}
+
+	// Its slice is used up
+	const std::uint64_t slice = GetIdealSlice(current);
+	if (mCurrentRun > slice) {
+		ThreadPrint("[FAIR] PID[", current->mProcessIdentifier, "] USED ITS [", slice, " tick] SLICE");
+		return true;
+	}
+
+	// ... or it has had at least the minimum granularity, and has got a whole slice ahead of the leftmost process
+	const TimelineKey& leftmost = *mTimeline.begin();
+	if (mCurrentRun >= cfg::gFairMinGranularity && current->mVirtualRuntime > leftmost.mVruntime + slice * VruntimeScale) {
+		ThreadPrint("[FAIR] PID[", current->mProcessIdentifier, "] (VRUNTIME ", current->mVirtualRuntime / VruntimeScale,
+		            ") IS A SLICE AHEAD OF PID[", leftmost.mPcb->mProcessIdentifier, "] (VRUNTIME ", leftmost.mVruntime / VruntimeScale, ")");
+		return true;
+	}
+
+	return false;
+}
+
+std::uint64_t FairScheduler::GetPreemptHorizon(const ProcessControlBlock* current) const
+{
+	if (mTimeline.empty()) {
+		return std::numeric_limits<std::uint64_t>::max();
+	}
+
+	// Nothing changes the timeline between events, so both checks in ShouldPreemptNow() can be solved for the first tick they pass on
+	const std::uint64_t slice    = GetIdealSlice(current);
+	const std::uint64_t run      = current == mCurrent ? mCurrentRun : 0;
+	const std::uint64_t vruntime = current == mCurrent ? current->mVirtualRuntime : GetPlacedVruntime(current);
+	const std::uint64_t step     = GetVruntimeStep(current);
+
+	const std::uint64_t sliceTick   = run >= slice ? 1 : slice - run + 1;
+	const std::uint64_t minimumTick = run >= cfg::gFairMinGranularity ? 1 : cfg::gFairMinGranularity - run;
+	const std::uint64_t aheadAt     = mTimeline.begin()->mVruntime + slice * VruntimeScale;
+	const std::uint64_t aheadTick   = vruntime + step > aheadAt ? 1 : (aheadAt - vruntime) / step + 1;
+
+	return std::min(sliceTick, std::max(minimumTick, aheadTick));
+}
+
+ProcessControlBlock* FairScheduler::PopNext()
+{
+	const LockScope lock = Lock();
+	if (mTimeline.empty()) {
+		return nullptr;
+	}
+
+	// The leftmost node is found without searching, it only has to be unlinked
+	ProcessControlBlock* next = mTimeline.begin()->mPcb;
+	mTimeline.erase(mTimeline.begin());
+	mWork.mMoves++;
+	mReadyWeight -= GetWeight(next);
+	return next;
+}
+
+ProcessControlBlock* FairScheduler::PeekNext() { return mTimeline.empty() ? nullptr : mTimeline.begin()->mPcb; }
+
+std::size_t FairScheduler::PopNextBatch(std::span<ProcessControlBlock*> out)
+{
+	const LockScope lock = Lock();
+
+	// The leftmost run of the timeline, erased as one range
+	auto end          = mTimeline.begin();
+	std::size_t count = 0;
+	for (; count < out.size() && end != mTimeline.end(); ++end) {
+		out[count++] = end->mPcb;
+		mReadyWeight -= GetWeight(end->mPcb);
+	}
+
+	mTimeline.erase(mTimeline.begin(), end);
+	mWork.mMoves += count;
+	return count;
+}
+
+std::size_t FairScheduler::PeekNextBatch(std::span<ProcessControlBlock*> out)
+{
+	std::size_t count = 0;
+	for (auto it = mTimeline.begin(); count < out.size() && it != mTimeline.end(); ++it) {
+		out[count++] = it->mPcb;
+	}
+
+	return count;
+}
+
+bool FairScheduler::VisitProcesses(const Visitor& visit) const
+{
+	return std::all_of(mFullProcessList.begin(), mFullProcessList.end(), visit);
+}
+
+bool FairScheduler::VisitReady(const Visitor& visit) const
+{
+	return std::all_of(mTimeline.begin(), mTimeline.end(), [&visit](const TimelineKey& key) { return visit(key.mPcb); });
+}
@@ -0,0 +1,91 @@
+#ifndef _FAIRSCHEDULER_HPP
+#define _FAIRSCHEDULER_HPP
+
+#include <cstdint>
+#include <vector>
+#include <set>
+
+#include "../IScheduler.hpp"
+#include "../util.hpp"
+
+// Completely-fair style scheduler, modelled on Linux CFS
+// - Each process' priority maps to a weight, and it accumulates virtual runtime at a rate inversely proportional to it
+// - Whoever has the least virtual runtime runs next, so over time every process gets CPU in proportion to its weight
+// - There's no fixed quantum: the running process' slice is its share of the target latency (never under the minimum granularity),
+//   and it's preempted early if it gets too far ahead of the leftmost process, or by a waking process that's far enough behind
+// The ready set is a red-black tree ordered by virtual runtime, the leftmost (next) process is always at begin()
+// For specific function info see 'IScheduler.hpp'
+class FairScheduler final : public IScheduler {
+public:
+	// Virtual runtime is in 1/1024ths of a tick, a priority 0 process gaining 1024 for every tick it computes
+	static constexpr std::uint64_t VruntimeScale = 1024;
+
+	virtual ~FairScheduler() = default;
+
+	ProcessControlBlock* PopNext() override;
+	ProcessControlBlock* PeekNext() override;
+	bool VisitProcesses(const Visitor& visit) const override;
+	bool VisitReady(const Visitor& visit) const override;
+	std::size_t GetProcessCount() const override { return mFullProcessList.size(); }
+	std::size_t GetReadyCount() const override { return mTimeline.size(); }
+
+	SchedulingAlgorithm GetAlgorithm() const override { return SchedulingAlgorithm::Fair; }
+
+	void OnNewProcess(ProcessControlBlock*) override;
+	void OnReadyProcess(ProcessControlBlock*) override;
+	void OnTerminate(ProcessControlBlock*) override;
+	void OnPriorityChanged(ProcessControlBlock*) override { } // Only the Priority algorithm ever changes them
+	bool ShouldPreempt(ProcessControlBlock* current, ProcessControlBlock* incoming) override;
+
+	// NOTE: OnReadyBatch() is left one at a time, where each process is placed depends on the minimum virtual runtime the last left
+	void OnTerminateBatch(std::span<ProcessControlBlock* const> batch) override;
+	std::size_t PopNextBatch(std::span<ProcessControlBlock*> out) override;
+	std::size_t PeekNextBatch(std::span<ProcessControlBlock*> out) override;
+
+	void OnBlocked(ProcessControlBlock*) override;
+	void OnRunning(ProcessControlBlock* current, std::uint64_t ticks) override;
+	bool ShouldPreemptNow(ProcessControlBlock* current) override;
+	std::uint64_t GetPreemptHorizon(const ProcessControlBlock* current) const override;
+
+private:
+	struct TimelineKey {
+		std::uint64_t mVruntime   = 0;
+		std::uint32_t mIdentifier = 0; // Breaks ties deterministically, PIDs being unique among live processes
+		ProcessControlBlock* mPcb = nullptr;
+
+		inline bool operator<(const TimelineKey& other) const
+		{
+			return mVruntime != other.mVruntime ? mVruntime < other.mVruntime : mIdentifier < other.mIdentifier;
+		}
+	};
+
+	static std::uint64_t GetWeight(const ProcessControlBlock* pcb);
+
+	// Virtual runtime gained per tick of computing, fixed per weight so charging N ticks at once is exact
+	static std::uint64_t GetVruntimeStep(const ProcessControlBlock* pcb);
+
+	static TimelineKey MakeKey(ProcessControlBlock* pcb);
+
+	// How many ticks 'current' should run for, given everything that's ready alongside it
+	std::uint64_t GetIdealSlice(const ProcessControlBlock* current) const;
+
+	// Where a process coming (back) in sits on the timeline, so a long sleep doesn't bank a huge amount of CPU
+	std::uint64_t GetPlacedVruntime(const ProcessControlBlock* pcb) const;
+
+	void Enqueue(ProcessControlBlock* pcb);
+	void UpdateMinVruntime();
+
+	// Counts the work of one insertion into or removal from 'mTimeline'
+	void CountTimelineSearch();
+
+	std::set<TimelineKey> mTimeline;
+	std::uint64_t mReadyWeight = 0; // Sum of the weights on 'mTimeline'
+	std::uint64_t mMinVruntime = 0; // Only ever moves forward, everything new is placed relative to it
+
+	ProcessControlBlock* mCurrent = nullptr; // The process being charged by OnRunning()
+	std::uint64_t mCurrentRun     = 0;       // Ticks it has computed since it was last picked
+
+	std::vector<ProcessControlBlock*> mFullProcessList;
+};
+
+#endif
@@ -0,0 +1,400 @@
+#include "GroupScheduler.hpp"
+#include "../Process.hpp"
+#include "../CPU.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <array>
+#include <iomanip>
+#include <numeric>
+#include <string>
+
+GroupScheduler::GroupScheduler(const PolicyFactory& makePolicy)
+{
+	// Every group configured gets its own policy, there's always at least one
+	const std::size_t count = std::clamp<std::size_t>(cfg::gGroupShares.size(), 1, MaxGroups);
+	mGroups.resize(count);
+
+	std::uint64_t quotaPeriod = 0;
+	for (std::size_t i = 0; i < count; ++i) {
+		Group& group  = mGroups[i];
+		group.mPolicy = makePolicy();
+		group.mWeight = std::max<std::uint32_t>(i < cfg::gGroupShares.size() ? cfg::gGroupShares[i] : 1, 1);
+		group.mStride = StrideScale / group.mWeight;
+
+		// A quota of the whole period (or more) is no quota at all
+		const std::uint32_t percent = i < cfg::gGroupQuotas.size() ? cfg::gGroupQuotas[i] : 0;
+		if (percent && percent < 100 && cfg::gGroupPeriod) {
+			group.mQuota = std::max<std::uint64_t>(static_cast<std::uint64_t>(cfg::gGroupPeriod) * percent / 100, 1);
+			quotaPeriod  = cfg::gGroupPeriod;
+		}
+	}
+
+	// There's only one periodic callback, so it runs often enough for both the quotas and the policies (e.g. the MLFQ boost)
+	const std::uint64_t policyPeriod = mGroups.front().mPolicy->GetPeriod();
+	mPeriod       = quotaPeriod && policyPeriod ? std::gcd(quotaPeriod, policyPeriod) : std::max(quotaPeriod, policyPeriod);
+	mQuotaPeriod  = quotaPeriod ? quotaPeriod / mPeriod : 0;
+	mPolicyPeriod = policyPeriod ? policyPeriod / mPeriod : 0;
+}
+
+std::size_t GroupScheduler::GetGroupIndex(const ProcessControlBlock* pcb) const
+{
+	return std::min<std::size_t>(pcb->mGroup, mGroups.size() - 1);
+}
+
+std::size_t GroupScheduler::PickGroup(std::size_t except) const
+{
+	std::size_t best = NoGroup;
+	for (std::size_t i = 0; i < mGroups.size(); ++i) {
+		const Group& group = mGroups[i];
+		if (i == except || group.mIsThrottled || !group.mPolicy->PeekNext()) {
+			continue;
+		}
+
+		if (best == NoGroup || group.mPass < mGroups[best].mPass) {
+			best = i;
+		}
+	}
+
+	return best;
+}
+
+void GroupScheduler::MarkReady(ProcessControlBlock* pcb)
+{
+	const std::size_t index = GetGroupIndex(pcb);
+	Group& group            = mGroups[index];
+	if (index != mCurrentGroup && !group.mPolicy->PeekNext()) {
+		group.mPass = std::max(group.mPass, mGlobalPass);
+	}
+
+	pcb->mReadySince = pcb->mProcess.GetParentCPU()->GetTick();
+}
+
+template <typename Handle>
+void GroupScheduler::SplitBatch(std::span<ProcessControlBlock* const> batch, Handle&& handle)
+{
+	// Nearly always a single group, which gets the whole batch as it is
+	if (mGroups.size() == 1) {
+		handle(mGroups.front(), batch);
+		return;
+	}
+
+	for (std::size_t i = 0; i < mGroups.size(); ++i) {
+		mSplit.clear();
+		std::copy_if(batch.begin(), batch.end(), std::back_inserter(mSplit), [this, i](const ProcessControlBlock* pcb) {
+			return GetGroupIndex(pcb) == i;
+		});
+
+		if (!mSplit.empty()) {
+			handle(mGroups[i], std::span<ProcessControlBlock* const>(mSplit));
+		}
+	}
+}
+
+void GroupScheduler::OnNewProcess(ProcessControlBlock* pcb)
+{
+	const LockScope lock = Lock();
+	Group& group = GetGroup(pcb);
+	group.mProcesses++;
+
+	if (pcb->mState.load() == ProcessState::Ready) {
+		MarkReady(pcb);
+	}
+
+	group.mPolicy->OnNewProcess(pcb);
+}
+
+void GroupScheduler::OnReadyProcess(ProcessControlBlock* pcb)
+{
+	const LockScope lock = Lock();
+	MarkReady(pcb);
+	GetGroup(pcb).mPolicy->OnReadyProcess(pcb);
+}
+
+void GroupScheduler::OnTerminate(ProcessControlBlock* pcb)
+{
+	const LockScope lock = Lock();
+	Group& group = GetGroup(pcb);
+	group.mFinished++;
+	group.mPolicy->OnTerminate(pcb);
+}
+
+void GroupScheduler::OnReadyBatch(std::span<ProcessControlBlock* const> batch)
+{
+	const LockScope lock = Lock();
+
+	// All marked before any are queued, the first in a group with nothing ready catches its pass up and the rest find it caught up
+	for (ProcessControlBlock* pcb : batch) {
+		MarkReady(pcb);
+	}
+
+	SplitBatch(batch, [](Group& group, std::span<ProcessControlBlock* const> share) { group.mPolicy->OnReadyBatch(share); });
+}
+
+void GroupScheduler::OnTerminateBatch(std::span<ProcessControlBlock* const> batch)
+{
+	const LockScope lock = Lock();
+	SplitBatch(batch, [](Group& group, std::span<ProcessControlBlock* const> share) {
+		group.mFinished += share.size();
+		group.mPolicy->OnTerminateBatch(share);
+	});
+}
+
+void GroupScheduler::OnPriorityChanged(ProcessControlBlock* pcb)
+{
+	const LockScope lock = Lock();
+	GetGroup(pcb).mPolicy->OnPriorityChanged(pcb);
+}
+
+bool GroupScheduler::ShouldPreempt(ProcessControlBlock* current, ProcessControlBlock* incoming)
+{
+	// Groups only take turns at slice boundaries, a wakeup can only preempt something in its own group
+	if (GetGroupIndex(current) != GetGroupIndex(incoming)) {
+		return false;
+	}
+
+	return GetGroup(incoming).mPolicy->ShouldPreempt(current, incoming);
+}
+
+Admission GroupScheduler::GetAdmission(const ProcessControlBlock* pcb) const { return GetGroup(pcb).mPolicy->GetAdmission(pcb); }
+
+std::uint64_t GroupScheduler::GetTimeQuantum(const ProcessControlBlock* pcb) const { return GetGroup(pcb).mPolicy->GetTimeQuantum(pcb); }
+
+void GroupScheduler::OnBurstComplete(ProcessControlBlock* pcb, std::uint32_t length)
+{
+	GetGroup(pcb).mPolicy->OnBurstComplete(pcb, length);
+}
+
+void GroupScheduler::OnQuantumExpired(ProcessControlBlock* pcb) { GetGroup(pcb).mPolicy->OnQuantumExpired(pcb); }
+
+void GroupScheduler::OnBlocked(ProcessControlBlock* pcb) { GetGroup(pcb).mPolicy->OnBlocked(pcb); }
+
+void GroupScheduler::OnRunning(ProcessControlBlock* current, std::uint64_t ticks)
+{
+	const std::size_t index = GetGroupIndex(current);
+	Group& group            = mGroups[index];
+
+	// Picked straight off a wakeup preemption rather than through PopNext()
+	if (index != mCurrentGroup) {
+		mCurrentGroup = index;
+		mCurrentRun   = 0;
+	}
+
+	group.mPass += ticks * group.mStride;
+	group.mUsed += ticks;
+	group.mCpuTicks += ticks;
+	mCurrentRun += ticks;
+
+	if (group.mQuota && !group.mIsThrottled && group.mUsed >= group.mQuota) {
+		group.mIsThrottled = true;
+		group.mThrottles++;
+		ThreadPrint("[GROUP] GROUP[", index, "] THROTTLED, USED ITS [", group.mQuota, " tick] QUOTA FOR THIS PERIOD");
+	}
+
+	group.mPolicy->OnRunning(current, ticks);
+}
+
+bool GroupScheduler::ShouldPreemptNow(ProcessControlBlock* current)
+{
+	const std::size_t index = GetGroupIndex(current);
+	Group& group            = mGroups[index];
+
+	// Out of quota, it has to stop whether or not anything else can run
+	if (group.mIsThrottled) {
+		return true;
+	}
+
+	if (group.mPolicy->ShouldPreemptNow(current)) {
+		return true;
+	}
+
+	// Had its slice, and another group is now behind it
+	const std::size_t other = PickGroup(index);
+	if (mCurrentRun < cfg::gGroupSlice || other == NoGroup || mGroups[other].mPass >= group.mPass) {
+		return false;
+	}
+
+	ThreadPrint("[GROUP] GROUP[", other, "] (PASS ", mGroups[other].mPass / StrideScale, ") TAKES OVER FROM GROUP[", index, "] (PASS ",
+	            group.mPass / StrideScale, ")");
+	return true;
+}
+
+std::uint64_t GroupScheduler::GetPreemptHorizon(const ProcessControlBlock* current) const
+{
+	const std::size_t index = GetGroupIndex(current);
+	const Group& group      = mGroups[index];
+	if (group.mIsThrottled) {
+		return 1;
+	}
+
+	std::uint64_t horizon = group.mPolicy->GetPreemptHorizon(current);
+
+	// Running out of quota
+	if (group.mQuota) {
+		horizon = std::min(horizon, group.mQuota - group.mUsed);
+	}
+
+	// Nothing changes the other groups' passes between events, so the takeover in ShouldPreemptNow() can be solved for exactly
+	const std::size_t other = PickGroup(index);
+	if (other != NoGroup) {
+		const std::uint64_t run       = index == mCurrentGroup ? mCurrentRun : 0;
+		const std::uint64_t otherPass = mGroups[other].mPass;
+
+		const std::uint64_t sliceTick = run >= cfg::gGroupSlice ? 1 : cfg::gGroupSlice - run;
+		const std::uint64_t aheadTick = group.mPass + group.mStride > otherPass ? 1 : (otherPass - group.mPass) / group.mStride + 1;
+		horizon                       = std::min(horizon, std::max(sliceTick, aheadTick));
+	}
+
+	return horizon;
+}
+
+void GroupScheduler::OnPeriodic()
+{
+	const LockScope lock = Lock();
+	mPeriodCount++;
+
+	if (mQuotaPeriod && mPeriodCount % mQuotaPeriod == 0) {
+		for (std::size_t i = 0; i < mGroups.size(); ++i) {
+			Group& group = mGroups[i];
+			group.mUsed  = 0;
+
+			if (group.mIsThrottled) {
+				group.mIsThrottled = false;
+				ThreadPrint("[GROUP] GROUP[", i, "] UNTHROTTLED, NEW PERIOD");
+			}
+		}
+	}
+
+	if (mPolicyPeriod && mPeriodCount % mPolicyPeriod == 0) {
+		for (Group& group : mGroups) {
+			group.mPolicy->OnPeriodic();
+		}
+	}
+}
+
+ProcessControlBlock* GroupScheduler::PopNext()
+{
+	const LockScope lock = Lock();
+
+	// Every group's pass is looked at to find the lowest
+	const std::size_t index = PickGroup();
+	mWork.mComparisons += mGroups.size();
+	if (index == NoGroup) {
+		return nullptr;
+	}
+
+	Group& group              = mGroups[index];
+	ProcessControlBlock* next = group.mPolicy->PopNext();
+	mGlobalPass               = std::max(mGlobalPass, group.mPass);
+
+	if (index != mCurrentGroup) {
+		mCurrentGroup = index;
+		mCurrentRun   = 0;
+	}
+
+	const std::uint64_t wait = next->mProcess.GetParentCPU()->GetTick() - next->mReadySince;
+	group.mDispatches++;
+	group.mTotalWait += wait;
+	group.mMaxWait = std::max(group.mMaxWait, wait);
+
+	return next;
+}
+
+ProcessControlBlock* GroupScheduler::PeekNext()
+{
+	const std::size_t index = PickGroup();
+	return index == NoGroup ? nullptr : mGroups[index].mPolicy->PeekNext();
+}
+
+std::size_t GroupScheduler::PeekNextBatch(std::span<ProcessControlBlock*> out)
+{
+	// Passes only move while something runs, so PopNext() empties the group it picks before moving on to the next lowest pass
+	std::array<std::size_t, MaxGroups> order;
+	std::size_t groups = 0;
+	for (std::size_t i = 0; i < mGroups.size(); ++i) {
+		if (!mGroups[i].mIsThrottled && mGroups[i].mPolicy->PeekNext()) {
+			order[groups++] = i;
+		}
+	}
+
+	// Stable, so equal passes keep going to the lowest index
+	std::stable_sort(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(groups),
+	                 [this](std::size_t a, std::size_t b) { return mGroups[a].mPass < mGroups[b].mPass; });
+
+	std::size_t count = 0;
+	for (std::size_t i = 0; i < groups && count < out.size(); ++i) {
+		count += mGroups[order[i]].mPolicy->PeekNextBatch(out.subspan(count));
+	}
+
+	return count;
+}
+
+bool GroupScheduler::VisitProcesses(const Visitor& visit) const
+{
+	return std::all_of(mGroups.begin(), mGroups.end(), [&visit](const Group& group) { return group.mPolicy->VisitProcesses(visit); });
+}
+
+bool GroupScheduler::VisitReady(const Visitor& visit) const
+{
+	return std::all_of(mGroups.begin(), mGroups.end(), [&visit](const Group& group) { return group.mPolicy->VisitReady(visit); });
+}
+
+std::size_t GroupScheduler::GetProcessCount() const
+{
+	std::size_t count = 0;
+	for (const Group& group : mGroups) {
+		count += group.mPolicy->GetProcessCount();
+	}
+
+	return count;
+}
+
+std::size_t GroupScheduler::GetReadyCount() const
+{
+	std::size_t count = 0;
+	for (const Group& group : mGroups) {
+		count += group.mPolicy->GetReadyCount();
+	}
+
+	return count;
+}
+
+void GroupScheduler::TakeWork(SchedulerWork& work)
+{
+	// Every call into a policy is made with this scheduler's lock already held, only what the policy did inside it is added
+	for (Group& group : mGroups) {
+		SchedulerWork inner;
+		group.mPolicy->TakeWork(inner);
+		mWork.mComparisons += inner.mComparisons;
+		mWork.mMoves += inner.mMoves;
+	}
+
+	IScheduler::TakeWork(work);
+}
+
+void GroupScheduler::PrintStats() const
+{
+	std::uint64_t totalTicks = 0;
+	for (const Group& group : mGroups) {
+		totalTicks += group.mCpuTicks;
+	}
+
+	for (const Group& group : mGroups) {
+		group.mPolicy->PrintStats();
+	}
+
+	for (std::size_t i = 0; i < mGroups.size(); ++i) {
+		const Group& group = mGroups[i];
+		const double share = totalTicks ? 100.0 * static_cast<double>(group.mCpuTicks) / static_cast<double>(totalTicks) : 0.0;
+		const double wait  = group.mDispatches ? static_cast<double>(group.mTotalWait) / static_cast<double>(group.mDispatches) : 0.0;
+
+		std::string quota = "NONE";
+		if (group.mQuota) {
+			quota = std::to_string(group.mQuota) + " / " + std::to_string(cfg::gGroupPeriod) + " TICKS";
+		}
+
+		ThreadPrint("GROUP[", i, "] WEIGHT [", group.mWeight, "] QUOTA [", quota, "] FINISHED [", group.mFinished, " / ", group.mProcesses,
+		            "] CPU [", group.mCpuTicks, " ticks] (", std::fixed, std::setprecision(2), share, "%) WAIT AVG [", wait,
+		            " ticks] MAX [", group.mMaxWait, " ticks] THROTTLED [", group.mThrottles, "] TIMES\r\n");
+	}
+}
@@ -0,0 +1,113 @@
+#ifndef _GROUPSCHEDULER_HPP
+#define _GROUPSCHEDULER_HPP
+
+#include <functional>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../IScheduler.hpp"
+#include "../util.hpp"
+
+// Group fair-share scheduling, in the spirit of cgroups' CPU controller
+// - Every process belongs to a group ('ProcessControlBlock::mGroup'), each with a share weight and an optional quota per period
+// - Groups take turns by stride scheduling: the one with the lowest pass runs, its pass growing by its stride (inversely proportional
+//   to its weight) for every tick it computes. A group keeps the CPU for at least a slice before one that's behind can take over
+// - Within a group, processes are picked by a scheduler of their own (any algorithm, one instance per group)
+// - A group that uses its whole quota is throttled, nothing in it runs again until the next period starts (even if the CPU idles)
+// For specific function info see 'IScheduler.hpp'
+class GroupScheduler final : public IScheduler {
+public:
+	// Strides are this divided by a group's weight, big enough that weights up to a few thousand stay distinct
+	static constexpr std::uint64_t StrideScale = 1 << 20;
+	static constexpr std::size_t MaxGroups     = 64;
+
+	// How each group orders its own processes
+	using PolicyFactory = std::function<std::unique_ptr<IScheduler>()>;
+
+	GroupScheduler(const PolicyFactory& makePolicy);
+	virtual ~GroupScheduler() = default;
+
+	ProcessControlBlock* PopNext() override;
+	ProcessControlBlock* PeekNext() override;
+	bool VisitProcesses(const Visitor& visit) const override;
+	bool VisitReady(const Visitor& visit) const override;
+	std::size_t GetProcessCount() const override;
+	std::size_t GetReadyCount() const override;
+
+	// Transparent, the CPU treats the processes exactly as it would under the per-group algorithm
+	SchedulingAlgorithm GetAlgorithm() const override { return mGroups.front().mPolicy->GetAlgorithm(); }
+
+	void OnNewProcess(ProcessControlBlock*) override;
+	void OnReadyProcess(ProcessControlBlock*) override;
+	void OnTerminate(ProcessControlBlock*) override;
+	void OnPriorityChanged(ProcessControlBlock*) override;
+	bool ShouldPreempt(ProcessControlBlock* current, ProcessControlBlock* incoming) override;
+
+	void OnReadyBatch(std::span<ProcessControlBlock* const> batch) override;
+	void OnTerminateBatch(std::span<ProcessControlBlock* const> batch) override;
+	std::size_t PeekNextBatch(std::span<ProcessControlBlock*> out) override;
+
+	Admission GetAdmission(const ProcessControlBlock*) const override;
+	std::uint64_t GetTimeQuantum(const ProcessControlBlock*) const override;
+	void OnBurstComplete(ProcessControlBlock* pcb, std::uint32_t length) override;
+	void OnQuantumExpired(ProcessControlBlock*) override;
+	void OnBlocked(ProcessControlBlock*) override;
+	void OnRunning(ProcessControlBlock* current, std::uint64_t ticks) override;
+	bool ShouldPreemptNow(ProcessControlBlock* current) override;
+	std::uint64_t GetPreemptHorizon(const ProcessControlBlock* current) const override;
+	std::uint64_t GetPeriod() const override { return mPeriod; }
+	void OnPeriodic() override;
+	void PrintStats() const override;
+	void TakeWork(SchedulerWork& work) override;
+
+private:
+	struct Group {
+		std::unique_ptr<IScheduler> mPolicy;
+		std::uint32_t mWeight = 1;
+		std::uint64_t mStride = StrideScale;
+		std::uint64_t mPass   = 0;
+		std::uint64_t mQuota  = 0; // Ticks per period (0 - uncapped)
+		std::uint64_t mUsed   = 0; // Ticks computed this period
+		bool mIsThrottled     = false;
+
+		// Results
+		std::uint64_t mProcesses  = 0;
+		std::uint64_t mFinished   = 0;
+		std::uint64_t mCpuTicks   = 0;
+		std::uint64_t mDispatches = 0;
+		std::uint64_t mTotalWait  = 0; // Between becoming ready and being picked
+		std::uint64_t mMaxWait    = 0;
+		std::uint64_t mThrottles  = 0;
+	};
+
+	static constexpr std::size_t NoGroup = ~std::size_t(0);
+
+	std::size_t GetGroupIndex(const ProcessControlBlock* pcb) const;
+	Group& GetGroup(const ProcessControlBlock* pcb) { return mGroups[GetGroupIndex(pcb)]; }
+	const Group& GetGroup(const ProcessControlBlock* pcb) const { return mGroups[GetGroupIndex(pcb)]; }
+
+	// The group with the lowest pass that has something ready and isn't throttled (or NoGroup), ties going to the lowest index
+	std::size_t PickGroup(std::size_t except = NoGroup) const;
+
+	// Called before a process is handed to its group's policy, a group coming back from having nothing to run can't bank its idle time
+	void MarkReady(ProcessControlBlock* pcb);
+
+	// Calls 'handle' with each group and its share of 'batch' (in the batch's order), skipping groups with none
+	template <typename Handle>
+	void SplitBatch(std::span<ProcessControlBlock* const> batch, Handle&& handle);
+
+	std::vector<Group> mGroups;
+	std::uint64_t mGlobalPass = 0; // The pass of the last group picked, only ever moving forward
+
+	std::vector<ProcessControlBlock*> mSplit; // SplitBatch() scratch
+
+	std::size_t mCurrentGroup   = NoGroup; // Whose process is on the CPU
+	std::uint64_t mCurrentRun   = 0;       // Ticks that group has computed since it took over
+	std::uint64_t mPeriod       = 0;       // How often OnPeriodic() runs, every quota period and policy period being a multiple of it
+	std::uint64_t mPeriodCount  = 0;       // OnPeriodic() calls so far
+	std::uint64_t mQuotaPeriod  = 0;       // Quotas refill every this many OnPeriodic() calls (0 - no quotas)
+	std::uint64_t mPolicyPeriod = 0;       // ... and the policies' own periodic work runs every this many (0 - none)
+};
+
+#endif
@@ -0,0 +1,221 @@
+#include "MLFQScheduler.hpp"
+#include "../Process.hpp"
+
+#include <algorithm>
+#include <bit>
+
+void MLFQScheduler::Enqueue(ProcessControlBlock* pcb)
+{
+	mLevels[pcb->mQueueLevel].push_back(pcb);
+	mWork.mMoves++;
+	mNonEmptyLevels |= std::uint64_t(1) << pcb->mQueueLevel;
+}
+
+void MLFQScheduler::OnNewProcess(ProcessControlBlock* pcb)
+{
+	const LockScope lock = Lock();
+	mFullProcessList.push_back(pcb);
+	mWork.mMoves++;
+
+	// Everything starts on the top level, it has to prove it's CPU-bound first
+	pcb->mQueueLevel = 0;
+	if (pcb->mState.load() == ProcessState::Ready) {
+		Enqueue(pcb);
+	}
+}
+
+void MLFQScheduler::OnReadyProcess(ProcessControlBlock* pcb)
+{
+	const LockScope lock = Lock();
+	Enqueue(pcb);
+}
+
+void MLFQScheduler::OnTerminate(ProcessControlBlock* pcb)
+{
+	const LockScope lock = Lock();
+	Erase(mFullProcessList, pcb);
+
+	std::deque<ProcessControlBlock*>& level = mLevels[pcb->mQueueLevel];
+	Erase(level, pcb);
+	if (level.empty()) {
+		mNonEmptyLevels &= ~(std::uint64_t(1) << pcb->mQueueLevel);
+	}
+}
+
+void MLFQScheduler::OnReadyBatch(std::span<ProcessControlBlock* const> batch)
+{
+	const LockScope lock = Lock();
+	for (ProcessControlBlock* pcb : batch) {
+		Enqueue(pcb);
+	}
+}
+
+void MLFQScheduler::OnTerminateBatch(std::span<ProcessControlBlock* const> batch)
+{
+	const LockScope lock = Lock();
+	EraseBatch(mFullProcessList, batch);
+
+	// Only the levels something in the batch sits on
+	std::uint64_t levels = 0;
+	for (const ProcessControlBlock* pcb : batch) {
+		levels |= std::uint64_t(1) << pcb->mQueueLevel;
+	}
+
+	for (levels &= mNonEmptyLevels; levels; levels &= levels - 1) {
+		const std::uint32_t level = static_cast<std::uint32_t>(std::countr_zero(levels));
+		EraseBatch(mLevels[level], batch);
+		if (mLevels[level].empty()) {
+			mNonEmptyLevels &= ~(std::uint64_t(1) << level);
+		}
+	}
+}
+
+bool MLFQScheduler::ShouldPreempt(ProcessControlBlock* current, ProcessControlBlock* incoming)
+{
+	// Only a strictly higher level takes over, equals wait their turn
+	if (incoming->mQueueLevel >= current->mQueueLevel) {
+		return false;
+	}
+
+	ThreadPrint("[MLFQ] PID[", incoming->mProcessIdentifier, "] (LEVEL ", incoming->mQueueLevel, ") PREEMPTS PID[",
+	            current->mProcessIdentifier, "] (LEVEL ", current->mQueueLevel, ")");
+	return true;
+}
+
+std::uint64_t MLFQScheduler::GetTimeQuantum(const ProcessControlBlock* pcb) const
+{
+	// Each level down gets twice the quantum of the one above it (capped, so the deepest levels can't overflow)
+	const std::uint64_t base = std::max<std::uint32_t>(cfg::gMlfqBaseQuantum, 1);
+	return base << std::min<std::uint32_t>(pcb->mQueueLevel, 31);
+}
+
+void MLFQScheduler::OnQuantumExpired(ProcessControlBlock* pcb)
+{
+	if (pcb->mQueueLevel + 1 < GetLevelCount()) {
+		pcb->mQueueLevel++;
+		ThreadPrint("[MLFQ] PID[", pcb->mProcessIdentifier, "] USED ITS QUANTUM, DEMOTED TO LEVEL [", pcb->mQueueLevel, "]");
+	}
+}
+
+void MLFQScheduler::OnBlocked(ProcessControlBlock* pcb)
+{
+	// Not queued while blocked, so it just comes back a level up
+	if (pcb->mQueueLevel > 0) {
+		pcb->mQueueLevel--;
+		ThreadPrint("[MLFQ] PID[", pcb->mProcessIdentifier, "] WAITING ON I/O, PROMOTED TO LEVEL [", pcb->mQueueLevel, "]");
+	}
+}
+
+void MLFQScheduler::OnPeriodic()
+{
+	const LockScope lock = Lock();
+
+	// Everything queued below the top joins the end of it, keeping the order between levels
+	std::deque<ProcessControlBlock*>& top = mLevels[0];
+	for (std::uint32_t level = 1; level < MaxLevels; ++level) {
+		top.insert(top.end(), mLevels[level].begin(), mLevels[level].end());
+		mWork.mMoves += mLevels[level].size();
+		mLevels[level].clear();
+	}
+
+	mNonEmptyLevels = top.empty() ? 0 : 1;
+
+	// ... and anything running or blocked comes back to the top too
+	for (ProcessControlBlock* pcb : mFullProcessList) {
+		pcb->mQueueLevel = 0;
+	}
+
+	ThreadPrint("[MLFQ] PRIORITY BOOST, [", mFullProcessList.size(), "] PROCESSES BACK ON LEVEL [0]");
+}
+
+ProcessControlBlock* MLFQScheduler::PopNext()
+{
+	const LockScope lock = Lock();
+	if (!mNonEmptyLevels) {
+		return nullptr;
+	}
+
+	// The lowest set bit is the highest level with anything ready
+	const std::uint32_t level               = static_cast<std::uint32_t>(std::countr_zero(mNonEmptyLevels));
+	std::deque<ProcessControlBlock*>& queue = mLevels[level];
+
+	ProcessControlBlock* next = queue.front();
+	queue.pop_front();
+	mWork.mMoves++;
+	if (queue.empty()) {
+		mNonEmptyLevels &= ~(std::uint64_t(1) << level);
+	}
+
+	return next;
+}
+
+ProcessControlBlock* MLFQScheduler::PeekNext()
+{
+	return mNonEmptyLevels ? mLevels[std::countr_zero(mNonEmptyLevels)].front() : nullptr;
+}
+
+std::size_t MLFQScheduler::PopNextBatch(std::span<ProcessControlBlock*> out)
+{
+	const LockScope lock = Lock();
+
+	// Whole runs off the front of each level, top down
+	std::size_t count = 0;
+	while (count < out.size() && mNonEmptyLevels) {
+		const std::uint32_t level               = static_cast<std::uint32_t>(std::countr_zero(mNonEmptyLevels));
+		std::deque<ProcessControlBlock*>& queue = mLevels[level];
+
+		const std::size_t taken = std::min(out.size() - count, queue.size());
+		std::copy_n(queue.begin(), taken, out.begin() + static_cast<std::ptrdiff_t>(count));
+		queue.erase(queue.begin(), queue.begin() + static_cast<std::ptrdiff_t>(taken));
+		mWork.mMoves += taken;
+		count += taken;
+
+		if (queue.empty()) {
+			mNonEmptyLevels &= ~(std::uint64_t(1) << level);
+		}
+	}
+
+	return count;
+}
+
+std::size_t MLFQScheduler::PeekNextBatch(std::span<ProcessControlBlock*> out)
+{
+	std::size_t count = 0;
+	for (std::uint64_t levels = mNonEmptyLevels; levels && count < out.size(); levels &= levels - 1) {
+		const std::deque<ProcessControlBlock*>& queue = mLevels[std::countr_zero(levels)];
+
+		const std::size_t taken = std::min(out.size() - count, queue.size());
+		std::copy_n(queue.begin(), taken, out.begin() + static_cast<std::ptrdiff_t>(count));
+		count += taken;
+	}
+
+	return count;
+}
+
+bool MLFQScheduler::VisitProcesses(const Visitor& visit) const
+{
+	return std::all_of(mFullProcessList.begin(), mFullProcessList.end(), visit);
+}
+
+bool MLFQScheduler::VisitReady(const Visitor& visit) const
+{
+	// Level by level, which is also the order they'd be picked in
+	for (std::uint64_t levels = mNonEmptyLevels; levels; levels &= levels - 1) {
+		const std::deque<ProcessControlBlock*>& queue = mLevels[std::countr_zero(levels)];
+		if (!std::all_of(queue.begin(), queue.end(), visit)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+std::size_t MLFQScheduler::GetReadyCount() const
+{
+	std::size_t count = 0;
+	for (std::uint64_t levels = mNonEmptyLevels; levels; levels &= levels - 1) {
+		count += mLevels[std::countr_zero(levels)].size();
+	}
+
+	return count;
+}
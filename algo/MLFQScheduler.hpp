@@ -0,0 +1,65 @@
+#ifndef _MLFQSCHEDULER_HPP
+#define _MLFQSCHEDULER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <array>
+
+#include "../IScheduler.hpp"
+#include "../util.hpp"
+
+// Multi-level feedback queue, in the style of the old O(1) Linux scheduler
+// - Every level is a FIFO with its own quantum, the top level (0) having the shortest and each level below twice the one above
+// - Using a whole quantum sinks a process one level, blocking on I/O lifts it one level, so interactive work stays on top
+// - Every so often everything is boosted back to the top, so CPU-bound processes can't starve
+// A bitmap of non-empty levels makes picking the next process a single bit scan, however many processes are ready
+// For specific function info see 'IScheduler.hpp'
+class MLFQScheduler final : public IScheduler {
+public:
+	static constexpr std::uint32_t MaxLevels = 64; // One bit per level in 'mNonEmptyLevels'
+
+	virtual ~MLFQScheduler() = default;
+
+	ProcessControlBlock* PopNext() override;
+	ProcessControlBlock* PeekNext() override;
+	bool VisitProcesses(const Visitor& visit) const override;
+	bool VisitReady(const Visitor& visit) const override;
+	std::size_t GetProcessCount() const override { return mFullProcessList.size(); }
+	std::size_t GetReadyCount() const override;
+
+	SchedulingAlgorithm GetAlgorithm() const override { return SchedulingAlgorithm::MLFQ; }
+
+	void OnNewProcess(ProcessControlBlock*) override;
+	void OnReadyProcess(ProcessControlBlock*) override;
+	void OnTerminate(ProcessControlBlock*) override;
+	void OnPriorityChanged(ProcessControlBlock*) override { }
+	bool ShouldPreempt(ProcessControlBlock* current, ProcessControlBlock* incoming) override;
+
+	void OnReadyBatch(std::span<ProcessControlBlock* const> batch) override;
+	void OnTerminateBatch(std::span<ProcessControlBlock* const> batch) override;
+	std::size_t PopNextBatch(std::span<ProcessControlBlock*> out) override;
+	std::size_t PeekNextBatch(std::span<ProcessControlBlock*> out) override;
+
+	std::uint64_t GetTimeQuantum(const ProcessControlBlock*) const override;
+	void OnQuantumExpired(ProcessControlBlock*) override;
+	void OnBlocked(ProcessControlBlock*) override;
+
+	// The periodic work is the priority boost
+	std::uint64_t GetPeriod() const override { return cfg::gMlfqBoostPeriod; }
+	void OnPeriodic() override;
+
+private:
+	void Enqueue(ProcessControlBlock* pcb);
+
+	// Read from the settings on use, the scheduler is created before they're asked for
+	static inline std::uint32_t GetLevelCount() { return std::clamp<std::uint32_t>(cfg::gMlfqLevelCount, 1, MaxLevels); }
+
+	std::array<std::deque<ProcessControlBlock*>, MaxLevels> mLevels;
+	std::uint64_t mNonEmptyLevels = 0; // Bit 'n' is set while level 'n' has anything ready
+
+	std::vector<ProcessControlBlock*> mFullProcessList;
+};
+
+#endif
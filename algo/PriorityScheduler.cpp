@@ -1,82 +1,90 @@
 #include "PriorityScheduler.hpp"
 #include "../Process.hpp"
-#include "../CPU.hpp"
 
 #include <algorithm>
 
 void PriorityScheduler::OnNewProcess(ProcessControlBlock* pcb)
 {
-	std::scoped_lock lk(mMutex);
+	const LockScope lock = Lock();
 	mFullProcessList.push_back(pcb);
+	mWork.mMoves++;
 
 	if (pcb->mState == ProcessState::Ready) {
-		mReadyList.push_back(pcb);
+		mReadyQueue.Push(pcb, pcb->mPriority);
 	}
 }
 
 void PriorityScheduler::OnReadyProcess(ProcessControlBlock* pcb)
 {
-	std::scoped_lock lk(mMutex);
+	const LockScope lock = Lock();
+	mReadyQueue.Push(pcb, pcb->mPriority);
+}
+
+void PriorityScheduler::OnReadyBatch(std::span<ProcessControlBlock* const> batch)
+{
+	const LockScope lock = Lock();
+	mReadyQueue.PushBatch(batch, [](const ProcessControlBlock* pcb) { return pcb->mPriority; });
+}
 
-	CPU* parent                  = pcb->mProcess.GetParentCPU();
-	ProcessControlBlock* current = parent->GetCurrentProcess();
+void PriorityScheduler::OnTerminateBatch(std::span<ProcessControlBlock* const> batch)
+{
+	const LockScope lock = Lock();
+	EraseBatch(mFullProcessList, batch);
+	for (ProcessControlBlock* pcb : batch) {
+		mReadyQueue.Remove(pcb);
+	}
+}
 
+bool PriorityScheduler::ShouldPreempt(ProcessControlBlock* current, ProcessControlBlock* incoming)
+{
 	// Check if we should preempt the current process
-	if (current && pcb->mPriority > current->mPriority) {
-		ThreadPrint("[PRIO] PID[", pcb->mProcessIdentifier, "] (PRIO ", pcb->mPriority, ") PREEMPTS PID[", current->mProcessIdentifier,
-		            "] (PRIO ", current->mPriority, ")");
-
-		mReadyList.push_back(current);
-		parent->ContextSwitch(pcb);
-	} else {
-		mReadyList.push_back(pcb);
+	if (incoming->mPriority <= current->mPriority) {
+		return false;
 	}
 
-	// Sort the ready list
-	SortReady();
+	ThreadPrint("[PRIO] PID[", incoming->mProcessIdentifier, "] (PRIO ", incoming->mPriority, ") PREEMPTS PID[", current->mProcessIdentifier,
+	            "] (PRIO ", current->mPriority, ")");
+	return true;
 }
 
 void PriorityScheduler::OnTerminate(ProcessControlBlock* pcb)
 {
-	std::scoped_lock lk(mMutex);
-	std::erase(mFullProcessList, pcb);
-	std::erase(mReadyList, pcb);
+	const LockScope lock = Lock();
+	Erase(mFullProcessList, pcb);
+	mReadyQueue.Remove(pcb);
 }
 
-void PriorityScheduler::SortReady()
+void PriorityScheduler::OnPriorityChanged(ProcessControlBlock* pcb)
 {
-	std::sort(mReadyList.begin(), mReadyList.end(),
-	          [&](ProcessControlBlock*& a, ProcessControlBlock*& b) { return a->mPriority > b->mPriority; });
+	const LockScope lock = Lock();
+	mReadyQueue.Update(pcb, pcb->mPriority);
 }
 
 ProcessControlBlock* PriorityScheduler::PopNext()
 {
-	std::scoped_lock lk(mMutex);
-	if (mReadyList.empty()) {
-		return nullptr;
-	}
-
-	SortReady();
-
-	ProcessControlBlock* next = mReadyList.front();
-	mReadyList.erase(mReadyList.begin());
-	return next;
+	const LockScope lock = Lock();
+	return mReadyQueue.IsEmpty() ? nullptr : mReadyQueue.Pop();
 }
 
-std::vector<ProcessControlBlock*> PriorityScheduler::GetProcessList() const
+ProcessControlBlock* PriorityScheduler::PeekNext() { return mReadyQueue.IsEmpty() ? nullptr : mReadyQueue.Top(); }
+
+std::size_t PriorityScheduler::PopNextBatch(std::span<ProcessControlBlock*> out)
 {
-	std::scoped_lock lk(mMutex);
-	return mFullProcessList;
+	const LockScope lock = Lock();
+	return mReadyQueue.PopBatch(out);
 }
 
-std::vector<ProcessControlBlock*> PriorityScheduler::GetReadyList() const
+std::size_t PriorityScheduler::PeekNextBatch(std::span<ProcessControlBlock*> out) { return mReadyQueue.PeekBatch(out); }
+
+bool PriorityScheduler::VisitProcesses(const Visitor& visit) const
 {
-	std::scoped_lock lk(mMutex);
-	return mReadyList;
+	return std::all_of(mFullProcessList.begin(), mFullProcessList.end(), visit);
 }
 
-bool PriorityScheduler::IsFullProcessListEmpty() const
+bool PriorityScheduler::VisitReady(const Visitor& visit) const { return mReadyQueue.VisitValues(visit); }
+
+void PriorityScheduler::TakeWork(SchedulerWork& work)
 {
-	std::scoped_lock lk(mMutex);
-	return mFullProcessList.empty();
+	mReadyQueue.TakeCounts(mWork.mComparisons, mWork.mMoves);
+	IScheduler::TakeWork(work);
 }
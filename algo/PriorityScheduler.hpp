@@ -3,32 +3,41 @@
 
 #include <deque>
 #include <vector>
-#include <mutex>
 
 #include "../IScheduler.hpp"
+#include "../IndexedHeap.hpp"
 #include "../util.hpp"
 
 // For specific function info see 'IScheduler.hpp'
-class PriorityScheduler : public IScheduler {
+class PriorityScheduler final : public IScheduler {
 public:
 	virtual ~PriorityScheduler() = default;
 
 	ProcessControlBlock* PopNext() override;
-	std::vector<ProcessControlBlock*> GetProcessList() const override;
-	std::vector<ProcessControlBlock*> GetReadyList() const override;
-	bool IsFullProcessListEmpty() const override;
+	ProcessControlBlock* PeekNext() override;
+	bool VisitProcesses(const Visitor& visit) const override;
+	bool VisitReady(const Visitor& visit) const override;
+	std::size_t GetProcessCount() const override { return mFullProcessList.size(); }
+	std::size_t GetReadyCount() const override { return mReadyQueue.GetSize(); }
 
 	SchedulingAlgorithm GetAlgorithm() const override { return SchedulingAlgorithm::Priority; }
 
 	void OnNewProcess(ProcessControlBlock*) override;
 	void OnReadyProcess(ProcessControlBlock*) override;
 	void OnTerminate(ProcessControlBlock*) override;
+	void OnPriorityChanged(ProcessControlBlock*) override;
+	bool ShouldPreempt(ProcessControlBlock* current, ProcessControlBlock* incoming) override;
 
-private:
-	void SortReady();
+	void OnReadyBatch(std::span<ProcessControlBlock* const> batch) override;
+	void OnTerminateBatch(std::span<ProcessControlBlock* const> batch) override;
+	std::size_t PopNextBatch(std::span<ProcessControlBlock*> out) override;
+	std::size_t PeekNextBatch(std::span<ProcessControlBlock*> out) override;
+
+	void TakeWork(SchedulerWork& work) override;
 
-	mutable std::mutex mMutex;
-	std::vector<ProcessControlBlock*> mReadyList;
+private:
+	// Highest priority first, ties going to whoever became ready first
+	IndexedHeap<ProcessControlBlock*, std::uint32_t, std::greater<std::uint32_t>> mReadyQueue;
 	std::vector<ProcessControlBlock*> mFullProcessList;
 };
 
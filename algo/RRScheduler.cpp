@@ -0,0 +1,79 @@
+#include "RRScheduler.hpp"
+#include "../Process.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+std::uint64_t RRScheduler::GetSharedQuantum() const
+{
+	return cfg::gRoundRobinPercentile && mQuantum ? mQuantum : cfg::gRoundRobinTimeQuantum;
+}
+
+std::uint64_t RRScheduler::GetTimeQuantum(const ProcessControlBlock* pcb) const
+{
+	const std::uint64_t quantum = GetSharedQuantum();
+	if (!cfg::gRoundRobinPercentile) {
+		return quantum;
+	}
+
+	// Cutting it off just short of finishing would cost a whole context switch for very little fairness. Only what was predicted to
+	// be left when the slice began counts, it's asked every tick so it can't shrink as the slice runs
+	const float_t remaining = std::ceil(std::max(0.0f, pcb->mPredictedBurst - static_cast<float_t>(pcb->mSliceProgress)));
+	if (remaining > static_cast<float_t>(quantum) && remaining <= static_cast<float_t>(quantum) * PredictedStretch) {
+		return static_cast<std::uint64_t>(remaining);
+	}
+
+	return quantum;
+}
+
+void RRScheduler::OnQuantumExpired(ProcessControlBlock* pcb)
+{
+	// Its next slice picks the burst up part way through
+	const ProcessWork* burst = pcb->mProcess.GetBurst();
+	pcb->mSliceProgress      = burst ? burst->mProgress : 0;
+}
+
+void RRScheduler::OnBurstComplete(ProcessControlBlock* pcb, std::uint32_t length)
+{
+	// ... and the next burst starts from nothing
+	pcb->mSliceProgress = 0;
+
+	const std::uint32_t percentile = std::min<std::uint32_t>(cfg::gRoundRobinPercentile, 100);
+	if (!percentile) {
+		return;
+	}
+
+	mWindow[mHead] = length;
+	mHead          = (mHead + 1) % WindowSize;
+	mCount         = std::min(mCount + 1, WindowSize);
+	if (mCount < MinimumSamples) {
+		return;
+	}
+
+	// The smallest length that at least 'percentile'% of the window fits in
+	std::array<std::uint32_t, WindowSize> sorted = mWindow;
+	const std::size_t rank                       = std::max<std::size_t>((mCount * percentile + 99) / 100, 1) - 1;
+	std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.begin() + mCount);
+	mWork.mComparisons += mCount;
+
+	// Any shorter and most of every slice would go on switching
+	const std::uint64_t quantum = std::max<std::uint64_t>({ sorted[rank], cfg::gDispatchLatency, 1 });
+	if (quantum == mQuantum) {
+		return;
+	}
+
+	mQuantum    = quantum;
+	mMinQuantum = mResizes ? std::min(mMinQuantum, quantum) : quantum;
+	mMaxQuantum = std::max(mMaxQuantum, quantum);
+	mResizes++;
+}
+
+void RRScheduler::PrintStats() const
+{
+	if (!cfg::gRoundRobinPercentile) {
+		return;
+	}
+
+	ThreadPrint("ADAPTIVE QUANTUM ENDED AT [", GetSharedQuantum(), " ticks] AFTER [", mResizes, "] RESIZES (RANGING [", mMinQuantum, " - ",
+	            mMaxQuantum, " ticks])\r\n");
+}
@@ -1,14 +1,45 @@
 #ifndef _RRSCHEDULER_HPP
 #define _RRSCHEDULER_HPP
 
+#include <array>
+
 #include "FCFSScheduler.hpp"
 
 // RR is just FCFS with a time quantum (the running time is tracked)
-class RRScheduler : public FCFSScheduler {
+// - The quantum is either fixed, or adapts to the CPU bursts seen so far: it's resized to a target percentile of the most recent
+//   burst lengths, so that share of bursts finishes within a single slice. It never drops under the cost of a context switch
+// - Adapting, a process whose predicted remainder is only a little over the quantum is given enough to finish it in one go
+class RRScheduler final : public FCFSScheduler {
 public:
+	// How many of the latest CPU bursts the adaptive quantum is sized from, and how many it needs before it adapts at all
+	static constexpr std::size_t WindowSize     = 64;
+	static constexpr std::size_t MinimumSamples = 8;
+
+	// A predicted burst up to this many times the quantum is let run to completion
+	static constexpr float_t PredictedStretch = 1.5f;
+
 	virtual ~RRScheduler() = default;
 
 	virtual SchedulingAlgorithm GetAlgorithm() const { return SchedulingAlgorithm::RoundRobin; }
+
+	std::uint64_t GetTimeQuantum(const ProcessControlBlock*) const override;
+	void OnBurstComplete(ProcessControlBlock*, std::uint32_t length) override;
+	void OnQuantumExpired(ProcessControlBlock*) override;
+	void PrintStats() const override;
+
+private:
+	// The quantum every process gets, before any stretching
+	std::uint64_t GetSharedQuantum() const;
+
+	std::array<std::uint32_t, WindowSize> mWindow {}; // Ring buffer of the latest CPU burst lengths
+	std::size_t mHead      = 0;
+	std::size_t mCount     = 0;
+	std::uint64_t mQuantum = 0; // Adaptive only, the target percentile of 'mWindow' (0 - not enough bursts seen yet)
+
+	// Results
+	std::uint64_t mResizes    = 0;
+	std::uint64_t mMinQuantum = 0;
+	std::uint64_t mMaxQuantum = 0;
 };
 
-#endif
\ No newline at end of file
+#endif
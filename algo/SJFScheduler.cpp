@@ -7,78 +7,76 @@
 
 void SJFScheduler::OnNewProcess(ProcessControlBlock* pcb)
 {
-	std::scoped_lock lk(mMutex);
-
+	const LockScope lock = Lock();
 	mFullProcessList.push_back(pcb);
+	mWork.mMoves++;
 
 	if (pcb->mState.load() == ProcessState::Ready) {
-		mReadyList.push_back(pcb);
+		mReadyQueue.Push(pcb, pcb->mProcess.GetPredictedBurstLength());
 	}
 }
 
 void SJFScheduler::OnReadyProcess(ProcessControlBlock* pcb)
 {
-	std::scoped_lock lk(mMutex);
-	mReadyList.push_back(pcb);
+	const LockScope lock = Lock();
+
+	// The prediction only moves while the process runs, so it can be keyed once here
+	mReadyQueue.Push(pcb, pcb->mProcess.GetPredictedBurstLength());
 }
 
 void SJFScheduler::OnTerminate(ProcessControlBlock* pcb)
 {
-	std::scoped_lock lk(mMutex);
-
-	std::erase(mFullProcessList, pcb);
-	std::erase(mReadyList, pcb);
+	const LockScope lock = Lock();
+	Erase(mFullProcessList, pcb);
+	mReadyQueue.Remove(pcb);
 }
 
-void SJFScheduler::SortReady()
+void SJFScheduler::OnReadyBatch(std::span<ProcessControlBlock* const> batch)
 {
-	std::sort(mReadyList.begin(), mReadyList.end(), [&](auto*& a, auto*& b) {
-		const float_t abl = a->mProcess.GetPredictedBurstLength();
-		const float_t bbl = b->mProcess.GetPredictedBurstLength();
-
-		return abl < bbl;
-	});
+	const LockScope lock = Lock();
+	mReadyQueue.PushBatch(batch, [](const ProcessControlBlock* pcb) { return pcb->mProcess.GetPredictedBurstLength(); });
 }
 
-ProcessControlBlock* SJFScheduler::PopNext()
+void SJFScheduler::OnTerminateBatch(std::span<ProcessControlBlock* const> batch)
 {
-	std::scoped_lock lk(mMutex);
-
-	if (mReadyList.empty()) {
-		return nullptr;
+	const LockScope lock = Lock();
+	EraseBatch(mFullProcessList, batch);
+	for (ProcessControlBlock* pcb : batch) {
+		mReadyQueue.Remove(pcb);
 	}
+}
 
-	SortReady();
-
-	ProcessControlBlock* next = *mReadyList.begin();
-
-#ifndef NDEBUG
-	if (!mReadyList.empty()) {
-		float_t shortestPredicted = next->mProcess.GetPredictedBurstLength();
-		for (const auto& elem : mReadyList) {
-			REQUIRE(elem->mProcess.GetPredictedBurstLength() >= shortestPredicted);
-		}
-	}
-#endif
+bool SJFScheduler::ShouldPreempt(ProcessControlBlock*, ProcessControlBlock*)
+{
+	// Non-preemptive, the running process always gets to finish its burst
+	return false;
+}
 
-	mReadyList.erase(mReadyList.begin());
-	return next;
+ProcessControlBlock* SJFScheduler::PopNext()
+{
+	const LockScope lock = Lock();
+	return mReadyQueue.IsEmpty() ? nullptr : mReadyQueue.Pop();
 }
 
-std::vector<ProcessControlBlock*> SJFScheduler::GetProcessList() const
+ProcessControlBlock* SJFScheduler::PeekNext() { return mReadyQueue.IsEmpty() ? nullptr : mReadyQueue.Top(); }
+
+std::size_t SJFScheduler::PopNextBatch(std::span<ProcessControlBlock*> out)
 {
-	std::scoped_lock lk(mMutex);
-	return mFullProcessList;
+	const LockScope lock = Lock();
+	return mReadyQueue.PopBatch(out);
 }
 
-std::vector<ProcessControlBlock*> SJFScheduler::GetReadyList() const
+std::size_t SJFScheduler::PeekNextBatch(std::span<ProcessControlBlock*> out) { return mReadyQueue.PeekBatch(out); }
+
+bool SJFScheduler::VisitProcesses(const Visitor& visit) const
 {
-	std::scoped_lock lk(mMutex);
-	return std::vector<ProcessControlBlock*>(mReadyList.begin(), mReadyList.end());
+	return std::all_of(mFullProcessList.begin(), mFullProcessList.end(), visit);
 }
 
-bool SJFScheduler::IsFullProcessListEmpty() const
+bool SJFScheduler::VisitReady(const Visitor& visit) const { return mReadyQueue.VisitValues(visit); }
+
+void SJFScheduler::TakeWork(SchedulerWork& work)
 {
-	std::scoped_lock lk(mMutex);
-	return mFullProcessList.empty();
+	mReadyQueue.TakeCounts(mWork.mComparisons, mWork.mMoves);
+	IScheduler::TakeWork(work);
 }
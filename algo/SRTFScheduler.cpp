@@ -1,99 +1,89 @@
 #include "SRTFScheduler.hpp"
 #include "../Process.hpp"
-#include "../CPU.hpp"
 
 #include <sstream>
 #include <algorithm>
 
 void SRTFScheduler::OnNewProcess(ProcessControlBlock* pcb)
 {
-	std::scoped_lock lk(mMutex);
-
+	const LockScope lock = Lock();
 	mFullProcessList.push_back(pcb);
+	mWork.mMoves++;
 
 	if (pcb->mState.load() == ProcessState::Ready) {
-		mReadyList.push_back(pcb);
+		mReadyQueue.Push(pcb, pcb->mProcess.GetRemainingPredictedBurstLength());
 	}
 }
 
 void SRTFScheduler::OnReadyProcess(ProcessControlBlock* newPcb)
 {
-	std::scoped_lock lk(mMutex);
-
-	CPU* parent                    = newPcb->mProcess.GetParentCPU();
-	ProcessControlBlock* oldPcb = parent->GetCurrentProcess();
-	if (oldPcb && oldPcb->mProcess.GetRemainingPredictedBurstLength() > newPcb->mProcess.GetRemainingPredictedBurstLength()) {
-		float_t currentRt = oldPcb->mProcess.GetRemainingPredictedBurstLength();
-		float_t newRt     = newPcb->mProcess.GetRemainingPredictedBurstLength();
-		
-		ThreadPrint("[SRTF] PID[", oldPcb->mProcessIdentifier, "] (", currentRt, ") PREEMPT BY PID[", newPcb->mProcessIdentifier, "](", newRt,
-		            ")");
-
-		// Old -> New, and ready up Old
-		parent->ContextSwitch(newPcb);
-		mReadyList.push_back(oldPcb);
-	} else {
-		mReadyList.push_back(newPcb);
-	}
+	const LockScope lock = Lock();
+
+	// Remaining time only moves while the process runs, so it can be keyed once here
+	mReadyQueue.Push(newPcb, newPcb->mProcess.GetRemainingPredictedBurstLength());
 }
 
-void SRTFScheduler::OnTerminate(ProcessControlBlock* pcb)
+void SRTFScheduler::OnReadyBatch(std::span<ProcessControlBlock* const> batch)
 {
-	std::scoped_lock lk(mMutex);
-
-	std::erase(mFullProcessList, pcb);
-	std::erase(mReadyList, pcb);
+	const LockScope lock = Lock();
+	mReadyQueue.PushBatch(batch, [](const ProcessControlBlock* pcb) { return pcb->mProcess.GetRemainingPredictedBurstLength(); });
 }
 
-void SRTFScheduler::SortReady()
+void SRTFScheduler::OnTerminateBatch(std::span<ProcessControlBlock* const> batch)
 {
-	std::sort(mReadyList.begin(), mReadyList.end(), [&](auto*& a, auto*& b) {
-		const float_t abl = a->mProcess.GetRemainingPredictedBurstLength();
-		const float_t bbl = b->mProcess.GetRemainingPredictedBurstLength();
-
-		return abl < bbl;
-	});
+	const LockScope lock = Lock();
+	EraseBatch(mFullProcessList, batch);
+	for (ProcessControlBlock* pcb : batch) {
+		mReadyQueue.Remove(pcb);
+	}
 }
 
-ProcessControlBlock* SRTFScheduler::PopNext()
+bool SRTFScheduler::ShouldPreempt(ProcessControlBlock* oldPcb, ProcessControlBlock* newPcb)
 {
-	std::scoped_lock lk(mMutex);
-
-	if (mReadyList.empty()) {
-		return nullptr;
+	if (oldPcb->mProcess.GetRemainingPredictedBurstLength() <= newPcb->mProcess.GetRemainingPredictedBurstLength()) {
+		return false;
 	}
 
-	SortReady();
+	float_t currentRt = oldPcb->mProcess.GetRemainingPredictedBurstLength();
+	float_t newRt     = newPcb->mProcess.GetRemainingPredictedBurstLength();
 
-	ProcessControlBlock* next = *mReadyList.begin();
+	ThreadPrint("[SRTF] PID[", oldPcb->mProcessIdentifier, "] (", currentRt, ") PREEMPT BY PID[", newPcb->mProcessIdentifier, "](", newRt,
+	            ")");
+	return true;
+}
 
-#ifndef NDEBUG
-	if (!mReadyList.empty()) {
-		float_t shortestPredicted = next->mProcess.GetRemainingPredictedBurstLength();
-		for (const auto& elem : mReadyList) {
-			REQUIRE(elem->mProcess.GetRemainingPredictedBurstLength() >= shortestPredicted);
-		}
-	}
-#endif
+void SRTFScheduler::OnTerminate(ProcessControlBlock* pcb)
+{
+	const LockScope lock = Lock();
+	Erase(mFullProcessList, pcb);
+	mReadyQueue.Remove(pcb);
+}
 
-	mReadyList.erase(mReadyList.begin());
-	return next;
+ProcessControlBlock* SRTFScheduler::PopNext()
+{
+	const LockScope lock = Lock();
+	return mReadyQueue.IsEmpty() ? nullptr : mReadyQueue.Pop();
 }
 
-std::vector<ProcessControlBlock*> SRTFScheduler::GetProcessList() const
+ProcessControlBlock* SRTFScheduler::PeekNext() { return mReadyQueue.IsEmpty() ? nullptr : mReadyQueue.Top(); }
+
+std::size_t SRTFScheduler::PopNextBatch(std::span<ProcessControlBlock*> out)
 {
-	std::scoped_lock lk(mMutex);
-	return mFullProcessList;
+	const LockScope lock = Lock();
+	return mReadyQueue.PopBatch(out);
 }
 
-std::vector<ProcessControlBlock*> SRTFScheduler::GetReadyList() const
+std::size_t SRTFScheduler::PeekNextBatch(std::span<ProcessControlBlock*> out) { return mReadyQueue.PeekBatch(out); }
+
+bool SRTFScheduler::VisitProcesses(const Visitor& visit) const
 {
-	std::scoped_lock lk(mMutex);
-	return std::vector<ProcessControlBlock*>(mReadyList.begin(), mReadyList.end());
+	return std::all_of(mFullProcessList.begin(), mFullProcessList.end(), visit);
 }
 
-bool SRTFScheduler::IsFullProcessListEmpty() const
+bool SRTFScheduler::VisitReady(const Visitor& visit) const { return mReadyQueue.VisitValues(visit); }
+
+void SRTFScheduler::TakeWork(SchedulerWork& work)
 {
-	std::scoped_lock lk(mMutex);
-	return mFullProcessList.empty();
+	mReadyQueue.TakeCounts(mWork.mComparisons, mWork.mMoves);
+	IScheduler::TakeWork(work);
 }
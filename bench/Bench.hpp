@@ -0,0 +1,16 @@
+#ifndef _BENCH_HPP
+#define _BENCH_HPP
+
+// Keeps a benchmark's result alive, so the optimiser can't throw away the work that went into it
+template <typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(_MSC_VER)
+	static volatile T sink;
+	sink = value;
+#else
+	asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+#endif
@@ -0,0 +1,156 @@
+// Compares the CPU's tick loop compiled for each algorithm ('StaticPolicy') against the dynamic one ('DynamicPolicy'), which makes every
+// scheduler call virtually and checks the algorithm at runtime for aging, quanta, etc.
+// Every run is a full simulation in virtual time without fast-forward, so every tick is a Step() of its own
+// - Both loops are handed identical processes (same seed) and do exactly the same work, only how the loop was compiled differs
+// - The simulator's logging is still formatted (then thrown away), which costs both loops the same
+
+#include <functional>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+
+#include "algo/PriorityScheduler.hpp"
+#include "algo/SRTFScheduler.hpp"
+#include "algo/FCFSScheduler.hpp"
+#include "algo/SJFScheduler.hpp"
+#include "algo/RRScheduler.hpp"
+#include "algo/MLFQScheduler.hpp"
+#include "algo/FairScheduler.hpp"
+#include "algo/EDFScheduler.hpp"
+#include "algo/GroupScheduler.hpp"
+#include "Process.hpp"
+#include "rng.hpp"
+#include "CPU.hpp"
+
+// The simulator's settings normally live in main.cpp, which isn't part of this program
+namespace cfg {
+	std::uint32_t gProcessCreationCost    = 5;
+	std::uint32_t gDispatchLatency        = 50;
+	std::uint32_t gProcessBurstMinimum    = 5;
+	std::uint32_t gProcessBurstMaximum    = 25;
+	std::uint32_t gInitialBurstPrediction = 1000;
+	std::uint32_t gBurstPredictor         = 0;
+	std::uint32_t gRoundRobinTimeQuantum  = 2500;
+	std::uint32_t gRoundRobinPercentile   = 0;
+	std::uint32_t gMlfqLevelCount         = 4;
+	std::uint32_t gMlfqBaseQuantum        = 500;
+	std::uint32_t gMlfqBoostPeriod        = 20000;
+	std::uint32_t gFairTargetLatency      = 20000;
+	std::uint32_t gFairMinGranularity     = 2500;
+	std::uint32_t gEdfAdmission           = 0;
+	bool gVirtualTime                     = true;
+	bool gFastForward                     = false;
+	std::uint32_t gIrqCoalesceCount       = 1;
+	std::uint32_t gIrqCoalesceWindow      = 100;
+	std::uint32_t gInterruptCost          = 0;
+	std::uint32_t gIoDeviceCount          = 0;
+	std::uint32_t gIoQueueDepth           = 1;
+	std::uint32_t gIoScheduler            = 0;
+	std::uint32_t gIoSeekCost             = 500;
+	std::uint32_t gAsyncIoChance          = 0;
+	std::uint32_t gDeadlineSlack          = 600;
+	std::uint32_t gGroupPeriod            = 10000;
+	std::uint32_t gGroupSlice             = 2500;
+	std::uint32_t gSchedulerOverhead      = 0;
+	std::uint32_t gSchedulerCompareCost   = 2;
+	std::uint32_t gSchedulerMoveCost      = 4;
+	std::uint32_t gSchedulerLockCost      = 25;
+	std::uint32_t gSchedulerTickLength    = 1000000;
+	std::vector<std::uint32_t> gGroupShares;
+	std::vector<std::uint32_t> gGroupQuotas;
+} // namespace cfg
+
+namespace {
+	constexpr std::uint32_t Seed    = 1234;
+	constexpr std::size_t Repeats   = 3; // Best of, to keep other things happening on the machine out of it
+	constexpr std::size_t Processes = 200;
+
+	using SchedulerMaker = std::function<std::unique_ptr<IScheduler>()>;
+
+	struct RunStats {
+		std::uint64_t mSteps = 0;
+		double mWallMs       = 0.0;
+	};
+
+	// 'tickLoop' nullptr - the dynamic loop
+	RunStats RunSimulation(const SchedulerMaker& makeScheduler, CPU::TickLoop tickLoop)
+	{
+		RunStats best;
+
+		// The simulator logs every step, none of which is wanted here
+		std::streambuf* console = std::cout.rdbuf(nullptr);
+		for (std::size_t i = 0; i < Repeats; ++i) {
+			rng::GetRandomEngine().seed(Seed);
+
+			CPU cpu(makeScheduler());
+			cpu.SetTickLoop(tickLoop);
+
+			for (std::size_t j = 0; j < Processes; ++j) {
+				ProcessControlBlock* pcb = cpu.GetArena().Create<ProcessControlBlock>(&cpu);
+				pcb->mGroup              = static_cast<std::uint32_t>(cfg::gGroupShares.empty() ? 0 : j % cfg::gGroupShares.size());
+				cpu.AddProcess(pcb);
+			}
+
+			const auto start   = std::chrono::steady_clock::now();
+			cpu.Run();
+			const double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			if (i == 0 || wallMs < best.mWallMs) {
+				best.mWallMs = wallMs;
+			}
+
+			best.mSteps = cpu.GetStepCount();
+		}
+
+		std::cout.rdbuf(console);
+		std::cout.clear();
+		return best;
+	}
+
+	template <typename Policy>
+	void Compare(const char* name, const SchedulerMaker& makeScheduler)
+	{
+		const RunStats dynamic = RunSimulation(makeScheduler, nullptr);
+		const RunStats policy  = RunSimulation(makeScheduler, CPU::GetTickLoop<Policy>());
+
+		// Millions of steps per second
+		const auto rate = [](const RunStats& stats) { return static_cast<double>(stats.mSteps) / stats.mWallMs / 1000.0; };
+
+		std::cout << std::setw(8) << name << " | " << std::setw(10) << policy.mSteps << " | " << std::setw(15) << std::fixed
+		          << std::setprecision(2) << rate(dynamic) << " | " << std::setw(14) << rate(policy) << " | " << std::setw(7)
+		          << rate(policy) / rate(dynamic) << "x" << std::endl;
+
+		// Both loops have to have simulated the very same run
+		REQUIRE(dynamic.mSteps == policy.mSteps);
+	}
+
+	template <typename Scheduler>
+	std::unique_ptr<IScheduler> Make()
+	{
+		return std::make_unique<Scheduler>();
+	}
+} // namespace
+
+int main()
+{
+	using Algo = SchedulingAlgorithm;
+
+	std::cout << "    Algo |      Steps | Dynamic (M/s) | Static (M/s) | Speed-up" << std::endl;
+
+	Compare<StaticPolicy<Algo::FCFS, FCFSScheduler>>("FCFS", Make<FCFSScheduler>);
+	Compare<StaticPolicy<Algo::SJF, SJFScheduler>>("SJF", Make<SJFScheduler>);
+	Compare<StaticPolicy<Algo::SRTF, SRTFScheduler>>("SRTF", Make<SRTFScheduler>);
+	Compare<StaticPolicy<Algo::RoundRobin, RRScheduler>>("RR", Make<RRScheduler>);
+	Compare<StaticPolicy<Algo::Priority, PriorityScheduler>>("Priority", Make<PriorityScheduler>);
+	Compare<StaticPolicy<Algo::MLFQ, MLFQScheduler>>("MLFQ", Make<MLFQScheduler>);
+	Compare<StaticPolicy<Algo::Fair, FairScheduler>>("Fair", Make<FairScheduler>);
+	Compare<StaticPolicy<Algo::EDF, EDFScheduler>>("EDF", Make<EDFScheduler>);
+
+	cfg::gGroupShares = { 1, 1 };
+	Compare<StaticPolicy<Algo::RoundRobin, GroupScheduler>>("RR/Group", [] { return std::make_unique<GroupScheduler>(Make<RRScheduler>); });
+	cfg::gGroupShares = {};
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,292 @@
+// Compares Round Robin (fixed and adaptive quantum) against the multi-level feedback queue and the fair scheduler on the same mixed
+// CPU / I/O-bound workload
+// Every run is a full simulation in virtual time, every algorithm being handed identical processes (same seed)
+// - Each process draws its own mix of CPU and I/O bursts, so some end up mostly computing and others mostly waiting on I/O
+// - 'I/O WAIT' is how long a process coming back from I/O sat in the ready queue, i.e. how responsive interactive work feels
+// The second table is a noisy neighbour: a group of 10 'victim' processes shares the CPU with an ever bigger group of others
+// - Without groups the victims get CPU in proportion to their numbers, with them (equal shares) they keep about half of it
+// - Capping the noisy group's quota hands the victims even more, at the cost of the CPU idling once they've finished
+
+#include <unordered_map>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <array>
+
+#include "algo/MLFQScheduler.hpp"
+#include "algo/FairScheduler.hpp"
+#include "algo/GroupScheduler.hpp"
+#include "algo/RRScheduler.hpp"
+#include "Process.hpp"
+#include "rng.hpp"
+#include "CPU.hpp"
+
+// The simulator's settings normally live in main.cpp, which isn't part of this program
+namespace cfg {
+	std::uint32_t gProcessCreationCost    = 5;
+	std::uint32_t gDispatchLatency        = 50;
+	std::uint32_t gProcessBurstMinimum    = 5;
+	std::uint32_t gProcessBurstMaximum    = 25;
+	std::uint32_t gInitialBurstPrediction = 1000;
+	std::uint32_t gBurstPredictor         = 0;
+	std::uint32_t gRoundRobinTimeQuantum  = 2500;
+	std::uint32_t gRoundRobinPercentile   = 0;
+	std::uint32_t gMlfqLevelCount         = 4;
+	std::uint32_t gMlfqBaseQuantum        = 500;
+	std::uint32_t gMlfqBoostPeriod        = 20000;
+	std::uint32_t gFairTargetLatency      = 20000;
+	std::uint32_t gFairMinGranularity     = 2500;
+	std::uint32_t gEdfAdmission           = 1;
+	bool gVirtualTime                     = true;
+	bool gFastForward                     = true;
+	std::uint32_t gIrqCoalesceCount       = 1;
+	std::uint32_t gIrqCoalesceWindow      = 100;
+	std::uint32_t gInterruptCost          = 0;
+	std::uint32_t gIoDeviceCount          = 0;
+	std::uint32_t gIoQueueDepth           = 1;
+	std::uint32_t gIoScheduler            = 0;
+	std::uint32_t gIoSeekCost             = 500;
+	std::uint32_t gAsyncIoChance          = 0;
+	std::uint32_t gDeadlineSlack          = 600;
+	std::uint32_t gGroupPeriod            = 10000;
+	std::uint32_t gGroupSlice             = 2500;
+	std::uint32_t gSchedulerOverhead      = 0;
+	std::uint32_t gSchedulerCompareCost   = 2;
+	std::uint32_t gSchedulerMoveCost      = 4;
+	std::uint32_t gSchedulerLockCost      = 25;
+	std::uint32_t gSchedulerTickLength    = 1000000;
+	std::vector<std::uint32_t> gGroupShares;
+	std::vector<std::uint32_t> gGroupQuotas;
+} // namespace cfg
+
+namespace {
+	struct GroupStats {
+		std::uint64_t mCpuTicks   = 0;
+		std::uint64_t mDispatches = 0;
+		std::uint64_t mTotalWait  = 0;
+		std::uint64_t mLastExit   = 0; // Tick the group's last process terminated
+	};
+
+	struct RunStats {
+		std::uint64_t mTicks       = 0;
+		std::uint64_t mDispatches  = 0;
+		std::uint64_t mTotalWait   = 0;
+		std::uint64_t mMaxWait     = 0;
+		std::uint64_t mIoReturns   = 0;
+		std::uint64_t mTotalIoWait = 0;
+		double mWallMs             = 0.0;
+
+		std::array<GroupStats, 2> mGroups; // Victims (0) and noisy neighbours (1)
+	};
+
+	// Passes everything through to the real scheduler, timing how long each process waits between becoming ready and being picked
+	class MeasuredScheduler : public IScheduler {
+	public:
+		MeasuredScheduler(std::unique_ptr<IScheduler> inner, RunStats& stats)
+		    : mInner(std::move(inner))
+		    , mStats(stats)
+		{
+		}
+
+		inline void SetCPU(const CPU* cpu) { mCpu = cpu; }
+
+		bool VisitProcesses(const Visitor& visit) const override { return mInner->VisitProcesses(visit); }
+		bool VisitReady(const Visitor& visit) const override { return mInner->VisitReady(visit); }
+		std::size_t GetProcessCount() const override { return mInner->GetProcessCount(); }
+		std::size_t GetReadyCount() const override { return mInner->GetReadyCount(); }
+		SchedulingAlgorithm GetAlgorithm() const override { return mInner->GetAlgorithm(); }
+
+		ProcessControlBlock* PopNext() override
+		{
+			ProcessControlBlock* next = mInner->PopNext();
+			if (!next) {
+				return nullptr;
+			}
+
+			Waiter& waiter           = mWaiters[next];
+			const std::uint64_t wait = mCpu->GetTick() - waiter.mReadyTick;
+			mStats.mDispatches++;
+			mStats.mTotalWait += wait;
+			mStats.mMaxWait = std::max(mStats.mMaxWait, wait);
+
+			GroupStats& group = GetGroup(next);
+			group.mDispatches++;
+			group.mTotalWait += wait;
+
+			if (waiter.mIsFromIO) {
+				mStats.mIoReturns++;
+				mStats.mTotalIoWait += wait;
+				waiter.mIsFromIO = false;
+			}
+
+			return next;
+		}
+
+		ProcessControlBlock* PeekNext() override { return mInner->PeekNext(); }
+		std::size_t PeekNextBatch(std::span<ProcessControlBlock*> out) override { return mInner->PeekNextBatch(out); }
+		void TakeWork(SchedulerWork& work) override { mInner->TakeWork(work); }
+
+		void OnNewProcess(ProcessControlBlock* pcb) override
+		{
+			mWaiters[pcb].mReadyTick = mCpu->GetTick();
+			mInner->OnNewProcess(pcb);
+		}
+
+		void OnReadyProcess(ProcessControlBlock* pcb) override
+		{
+			mWaiters[pcb].mReadyTick = mCpu->GetTick();
+			mInner->OnReadyProcess(pcb);
+		}
+
+		void OnTerminate(ProcessControlBlock* pcb) override
+		{
+			GetGroup(pcb).mLastExit = mCpu->GetTick();
+			mWaiters.erase(pcb);
+			mInner->OnTerminate(pcb);
+		}
+
+		void OnPriorityChanged(ProcessControlBlock* pcb) override { mInner->OnPriorityChanged(pcb); }
+		bool ShouldPreempt(ProcessControlBlock* current, ProcessControlBlock* incoming) override
+		{
+			return mInner->ShouldPreempt(current, incoming);
+		}
+
+		std::uint64_t GetTimeQuantum(const ProcessControlBlock* pcb) const override { return mInner->GetTimeQuantum(pcb); }
+		void OnBurstComplete(ProcessControlBlock* pcb, std::uint32_t length) override { mInner->OnBurstComplete(pcb, length); }
+		void OnQuantumExpired(ProcessControlBlock* pcb) override { mInner->OnQuantumExpired(pcb); }
+
+		void OnBlocked(ProcessControlBlock* pcb) override
+		{
+			mWaiters[pcb].mIsFromIO = true;
+			mInner->OnBlocked(pcb);
+		}
+
+		void OnRunning(ProcessControlBlock* pcb, std::uint64_t ticks) override
+		{
+			GetGroup(pcb).mCpuTicks += ticks;
+			mInner->OnRunning(pcb, ticks);
+		}
+
+		bool ShouldPreemptNow(ProcessControlBlock* pcb) override { return mInner->ShouldPreemptNow(pcb); }
+		std::uint64_t GetPreemptHorizon(const ProcessControlBlock* pcb) const override { return mInner->GetPreemptHorizon(pcb); }
+
+		std::uint64_t GetPeriod() const override { return mInner->GetPeriod(); }
+		void OnPeriodic() override { mInner->OnPeriodic(); }
+		void PrintStats() const override { mInner->PrintStats(); }
+
+		Admission GetAdmission(const ProcessControlBlock* pcb) const override { return mInner->GetAdmission(pcb); }
+
+	private:
+		GroupStats& GetGroup(const ProcessControlBlock* pcb) { return mStats.mGroups[std::min<std::size_t>(pcb->mGroup, 1)]; }
+
+		struct Waiter {
+			std::uint64_t mReadyTick = 0;
+			bool mIsFromIO           = false; // Readied by an I/O completion rather than a preemption / expired quantum
+		};
+
+		std::unique_ptr<IScheduler> mInner;
+		RunStats& mStats;
+		const CPU* mCpu = nullptr;
+		std::unordered_map<ProcessControlBlock*, Waiter> mWaiters;
+	};
+
+	// The first 'noisyCount' processes go in group 1, the rest in group 0, so the victims arrive behind every noisy process
+	RunStats RunSimulation(std::unique_ptr<IScheduler> scheduler, std::size_t processCount, std::uint32_t seed, std::size_t noisyCount = 0)
+	{
+		RunStats stats;
+
+		auto measured               = std::make_unique<MeasuredScheduler>(std::move(scheduler), stats);
+		MeasuredScheduler* observer = measured.get();
+
+		// The simulator logs every step, none of which is wanted here
+		std::streambuf* console = std::cout.rdbuf(nullptr);
+		{
+			rng::GetRandomEngine().seed(seed);
+
+			CPU cpu(std::move(measured));
+			observer->SetCPU(&cpu);
+
+			for (std::size_t i = 0; i < processCount; ++i) {
+				ProcessControlBlock* pcb = cpu.GetArena().Create<ProcessControlBlock>(&cpu);
+				pcb->mGroup              = i < noisyCount ? 1 : 0;
+				cpu.AddProcess(pcb);
+			}
+
+			const auto start = std::chrono::steady_clock::now();
+			cpu.Run();
+			stats.mWallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			stats.mTicks  = cpu.GetTick();
+		}
+
+		std::cout.rdbuf(console);
+		std::cout.clear();
+		return stats;
+	}
+
+	void PrintRow(std::size_t processCount, const char* name, const RunStats& stats)
+	{
+		const auto average = [](std::uint64_t total, std::uint64_t count) { return count ? static_cast<double>(total) / count : 0.0; };
+
+		std::cout << std::setw(9) << processCount << " | " << std::setw(4) << name << " | " << std::setw(11) << stats.mTicks << " | "
+		          << std::setw(10) << stats.mDispatches << " | " << std::setw(13) << std::fixed << std::setprecision(1)
+		          << average(stats.mTotalIoWait, stats.mIoReturns) << " | " << std::setw(13) << average(stats.mTotalWait, stats.mDispatches)
+		          << " | " << std::setw(10) << stats.mMaxWait << " | " << std::setw(9) << stats.mWallMs << std::endl;
+	}
+
+	void PrintGroupRow(std::size_t noisyCount, const char* setup, const RunStats& stats)
+	{
+		const GroupStats& victims = stats.mGroups[0];
+		const GroupStats& noisy   = stats.mGroups[1];
+
+		// How much of the CPU the victims got for as long as they were around
+		const double victimShare = victims.mLastExit ? 100.0 * victims.mCpuTicks / victims.mLastExit : 0.0;
+		const double victimWait  = victims.mDispatches ? static_cast<double>(victims.mTotalWait) / victims.mDispatches : 0.0;
+
+		std::cout << std::setw(11) << noisyCount << " | " << std::setw(5) << setup << " | " << std::setw(12) << std::fixed
+		          << std::setprecision(1) << victimShare << " | " << std::setw(15) << victimWait << " | " << std::setw(15)
+		          << victims.mLastExit << " | " << std::setw(15) << noisy.mLastExit << " | " << std::setw(9) << stats.mWallMs << std::endl;
+	}
+} // namespace
+
+int main()
+{
+	constexpr std::uint32_t Seed               = 1234;
+	constexpr std::uint32_t AdaptivePercentile = 80;
+
+	std::cout << "Processes | Algo |  Ticks (ms) | Dispatches | I/O wait avg. | Any wait avg. |  Max wait | Wall (ms)" << std::endl;
+
+	for (std::size_t processCount : { 10, 50, 200, 1000 }) {
+		PrintRow(processCount, "RR", RunSimulation(std::make_unique<RRScheduler>(), processCount, Seed));
+
+		cfg::gRoundRobinPercentile = AdaptivePercentile;
+		PrintRow(processCount, "ARR", RunSimulation(std::make_unique<RRScheduler>(), processCount, Seed));
+		cfg::gRoundRobinPercentile = 0;
+
+		PrintRow(processCount, "MLFQ", RunSimulation(std::make_unique<MLFQScheduler>(), processCount, Seed));
+		PrintRow(processCount, "Fair", RunSimulation(std::make_unique<FairScheduler>(), processCount, Seed));
+	}
+
+	constexpr std::size_t VictimCount = 10;
+	const auto makeGroups             = [] { return std::make_unique<GroupScheduler>([] { return std::make_unique<RRScheduler>(); }); };
+
+	std::cout << std::endl
+	          << "Noisy procs | Setup | Victim share | Victim wait avg | Victims done at |  Noisy done at | Wall (ms)" << std::endl;
+
+	for (std::size_t noisyCount : { 10, 50, 200 }) {
+		const std::size_t processCount = VictimCount + noisyCount;
+
+		cfg::gGroupShares = {};
+		cfg::gGroupQuotas = {};
+		PrintGroupRow(noisyCount, "None", RunSimulation(std::make_unique<RRScheduler>(), processCount, Seed, noisyCount));
+
+		cfg::gGroupShares = { 1, 1 };
+		PrintGroupRow(noisyCount, "Share", RunSimulation(makeGroups(), processCount, Seed, noisyCount));
+
+		cfg::gGroupQuotas = { 0, 25 };
+		PrintGroupRow(noisyCount, "Cap", RunSimulation(makeGroups(), processCount, Seed, noisyCount));
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,133 @@
+// Compares the process table's vectorised scans against walking a list of PCB pointers for the same answer
+// Half of the processes are ready, the pointer walk only visits those (like a scheduler's ready list) while the table scans every row
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <atomic>
+#include <random>
+#include <vector>
+#include <list>
+
+#include "ProcessTable.hpp"
+
+namespace {
+	// Stand-in for 'ProcessControlBlock', the same size and the same fields in the way of the ones a scan wants
+	struct ColdPcb {
+		std::atomic<std::uint32_t> mState = 0;
+		std::uint32_t mProcessIdentifier  = 0;
+		std::uint32_t mPriority           = 0;
+		std::uint64_t mIoTimer            = 0;
+		std::uint64_t mDeadline           = 0;
+		std::uint64_t mReadySince         = 0;
+		float_t mPredictedBurst           = 0.0f;
+		std::uint32_t mProgress           = 0;
+		std::uint8_t mRest[104]           = {}; // The process, its predictor, etc.
+	};
+
+	constexpr std::size_t RowsPerRun = 200'000'000;
+
+	struct Population {
+		std::list<ColdPcb> mPcbs;
+		std::vector<ColdPcb*> mReady; // In no particular order, like a heap's
+		ProcessTable mTable;
+	};
+
+	void Populate(Population& population, std::size_t processes)
+	{
+		std::default_random_engine re(1234);
+		std::uniform_int_distribution<std::uint32_t> priority(0, 10);
+		std::uniform_real_distribution<float_t> burst(100.0f, 2500.0f);
+		std::uniform_int_distribution<std::uint64_t> since(0, 1'000'000);
+
+		for (std::size_t i = 0; i < processes; ++i) {
+			ColdPcb& pcb           = population.mPcbs.emplace_back();
+			pcb.mProcessIdentifier = static_cast<std::uint32_t>(i);
+			pcb.mPriority          = priority(re);
+			pcb.mPredictedBurst    = burst(re);
+			pcb.mReadySince        = since(re);
+
+			if (i % 2 == 0) {
+				population.mReady.push_back(&pcb);
+				population.mTable.SetReady(pcb.mProcessIdentifier, pcb.mPriority, pcb.mPredictedBurst, pcb.mReadySince);
+			}
+		}
+
+		std::shuffle(population.mReady.begin(), population.mReady.end(), re);
+	}
+
+	// Microseconds per scan, 'answer' is kept so the scan can't be optimised away
+	template <typename Scan>
+	double Time(std::size_t processes, Scan&& scan, std::uint64_t& answer)
+	{
+		const std::size_t runs = std::max<std::size_t>(RowsPerRun / processes, 1);
+		const auto start       = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < runs; ++i) {
+			answer += static_cast<std::uint64_t>(scan());
+		}
+
+		return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(runs);
+	}
+
+	void PrintRow(std::size_t processes, const char* scan, double pointers, double table)
+	{
+		std::cout << std::fixed << std::setprecision(2);
+		std::cout << std::setw(9) << processes << " | " << std::setw(13) << scan << " | " << std::setw(17) << pointers << " | ";
+		std::cout << std::setw(10) << table << " | " << std::setw(7) << std::setprecision(1) << pointers / table << "x" << std::endl;
+	}
+} // namespace
+
+int main()
+{
+	std::cout << "Kernels: " << ProcessTable::GetKernelName() << std::endl;
+	std::cout << "Processes |          Scan | PCB pointers (us) | Table (us) | Speed-up" << std::endl;
+
+	for (std::size_t processes : { 10'000, 100'000, 1'000'000 }) {
+		Population population;
+		Populate(population, processes);
+
+		const std::vector<ColdPcb*>& ready = population.mReady;
+		const ProcessTable& table          = population.mTable;
+		std::uint64_t answer               = 0;
+
+		const double maxPointers = Time(processes, [&ready] {
+			std::uint32_t best = 0;
+			for (const ColdPcb* pcb : ready) {
+				best = std::max(best, pcb->mPriority);
+			}
+
+			return best;
+		}, answer);
+		const double maxTable = Time(processes, [&table] { return table.GetMaxReadyPriority(); }, answer);
+		PrintRow(processes, "max priority", maxPointers, maxTable);
+
+		const double minPointers = Time(processes, [&ready] {
+			float_t best = ProcessTable::NoRemaining;
+			for (const ColdPcb* pcb : ready) {
+				best = std::min(best, pcb->mPredictedBurst - static_cast<float_t>(pcb->mProgress));
+			}
+
+			return best;
+		}, answer);
+		const double minTable = Time(processes, [&table] { return table.GetMinReadyRemaining(); }, answer);
+		PrintRow(processes, "min remaining", minPointers, minTable);
+
+		const double agingPointers = Time(processes, [&ready] {
+			std::uint64_t best = ProcessTable::NoReadySince;
+			for (const ColdPcb* pcb : ready) {
+				best = std::min(best, pcb->mReadySince);
+			}
+
+			return best;
+		}, answer);
+		const double agingTable = Time(processes, [&table] { return table.GetOldestReadySince(); }, answer);
+		PrintRow(processes, "oldest ready", agingPointers, agingTable);
+
+		if (answer == 42) {
+			std::cout << "";
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,96 @@
+// Compares the old binary heap of I/O completions against the hierarchical timing wheel
+// Classic 'hold' model: N timers are always pending, every expiry schedules a fresh one 1000 - 7500 ticks out (the I/O burst range)
+
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <queue>
+
+#include "TimingWheel.hpp"
+#include "Bench.hpp"
+
+namespace {
+	struct HeapEvent {
+		std::uint64_t mWhen = 0;
+		std::uint64_t mId   = 0;
+		bool operator<(HeapEvent const& o) const { return mWhen > o.mWhen; }
+	};
+
+	constexpr std::size_t Operations = 2'000'000;
+
+	double BenchHeap(std::size_t pending)
+	{
+		std::default_random_engine re(1234);
+		std::uniform_int_distribution<std::uint64_t> delay(1000, 7500);
+
+		std::priority_queue<HeapEvent> heap;
+		for (std::size_t i = 0; i < pending; ++i) {
+			heap.push({ delay(re), i });
+		}
+
+		const auto start  = std::chrono::steady_clock::now();
+		std::uint64_t sum = 0;
+		for (std::size_t i = 0; i < Operations; ++i) {
+			const HeapEvent top = heap.top();
+			heap.pop();
+			sum += top.mId;
+			heap.push({ top.mWhen + delay(re), top.mId });
+		}
+
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		DoNotOptimize(sum);
+
+		return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(Operations);
+	}
+
+	double BenchWheel(std::size_t pending)
+	{
+		std::default_random_engine re(1234);
+		std::uniform_int_distribution<std::uint64_t> delay(1000, 7500);
+
+		TimingWheel<std::uint64_t> wheel;
+		for (std::size_t i = 0; i < pending; ++i) {
+			wheel.Insert(delay(re), i);
+		}
+
+		std::vector<std::uint64_t> expired;
+		const auto start  = std::chrono::steady_clock::now();
+		std::uint64_t sum = 0;
+		std::size_t done  = 0;
+		while (done < Operations) {
+			// Jump straight to the next batch, just like the CPU does in virtual time
+			wheel.Advance(wheel.GetNextExpiry(), expired);
+
+			const std::uint64_t now = wheel.GetTime();
+			for (std::uint64_t id : expired) {
+				sum += id;
+				wheel.Insert(now + delay(re), id);
+			}
+
+			done += expired.size();
+			expired.clear();
+		}
+
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		DoNotOptimize(sum);
+
+		return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(done);
+	}
+} // namespace
+
+int main()
+{
+	std::cout << "Pending timers | heap (ns/expiry) | wheel (ns/expiry)" << std::endl;
+
+	for (std::size_t pending : { 1'000, 10'000, 100'000, 1'000'000 }) {
+		const double heap  = BenchHeap(pending);
+		const double wheel = BenchWheel(pending);
+		std::cout << std::setw(14) << pending << " | " << std::setw(16) << std::fixed << std::setprecision(1) << heap << " | "
+		          << std::setw(17) << wheel << std::endl;
+	}
+
+	return EXIT_SUCCESS;
+}
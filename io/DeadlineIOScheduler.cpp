@@ -0,0 +1,41 @@
+#include <algorithm>
+
+#include "DeadlineIOScheduler.hpp"
+
+void DeadlineIOScheduler::Add(const IORequest& request)
+{
+	const Key key { request.mTrack, request.mSequence };
+	mSorted.emplace(key, request);
+	mFifo.push_back(key);
+}
+
+bool DeadlineIOScheduler::PopNext(std::uint32_t headTrack, std::uint64_t now, IORequest& out)
+{
+	if (mSorted.empty()) {
+		mFifo.clear();
+		return false;
+	}
+
+	while (!mSorted.contains(mFifo.front())) {
+		mFifo.pop_front();
+	}
+
+	// Starving, serve it now wherever the head is
+	auto it = mSorted.find(mFifo.front());
+	if (it->second.mDeadline > now) {
+		// Otherwise the next request on from the head, wrapping back to the first track
+		it = mSorted.lower_bound({ headTrack, 0 });
+		if (it == mSorted.end()) {
+			it = mSorted.begin();
+		}
+	}
+
+	out = it->second;
+	mSorted.erase(it);
+	return true;
+}
+
+bool DeadlineIOScheduler::Remove(const ProcessControlBlock* pcb)
+{
+	return std::erase_if(mSorted, [pcb](const auto& entry) { return entry.second.mPcb == pcb; }) != 0;
+}
@@ -0,0 +1,31 @@
+#ifndef _DEADLINEIOSCHEDULER_HPP
+#define _DEADLINEIOSCHEDULER_HPP
+
+#include <utility>
+#include <deque>
+#include <map>
+
+#include "IIOScheduler.hpp"
+
+// For specific function info see 'IIOScheduler.hpp'
+// Sweeps the tracks in one direction only (wrapping back to the start), so throughput stays close to SCAN,
+// but the oldest request is always checked first and serviced straight away once its deadline has passed
+class DeadlineIOScheduler : public IIOScheduler {
+public:
+	virtual ~DeadlineIOScheduler() = default;
+
+	void Add(const IORequest&) override;
+	bool PopNext(std::uint32_t headTrack, std::uint64_t now, IORequest& out) override;
+	bool Remove(const ProcessControlBlock*) override;
+
+	std::size_t GetSize() const override { return mSorted.size(); }
+	IOSchedulingPolicy GetPolicy() const override { return IOSchedulingPolicy::Deadline; }
+
+private:
+	using Key = std::pair<std::uint32_t, std::uint64_t>; // Track, then arrival
+
+	std::map<Key, IORequest> mSorted;
+	std::deque<Key> mFifo; // Arrival order, entries already serviced out of 'mSorted' are skipped once they reach the front
+};
+
+#endif
@@ -0,0 +1,21 @@
+#include <algorithm>
+
+#include "FIFOIOScheduler.hpp"
+
+void FIFOIOScheduler::Add(const IORequest& request) { mQueue.push_back(request); }
+
+bool FIFOIOScheduler::PopNext(std::uint32_t, std::uint64_t, IORequest& out)
+{
+	if (mQueue.empty()) {
+		return false;
+	}
+
+	out = mQueue.front();
+	mQueue.pop_front();
+	return true;
+}
+
+bool FIFOIOScheduler::Remove(const ProcessControlBlock* pcb)
+{
+	return std::erase_if(mQueue, [pcb](const IORequest& request) { return request.mPcb == pcb; }) != 0;
+}
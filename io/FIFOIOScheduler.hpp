@@ -0,0 +1,24 @@
+#ifndef _FIFOIOSCHEDULER_HPP
+#define _FIFOIOSCHEDULER_HPP
+
+#include <deque>
+
+#include "IIOScheduler.hpp"
+
+// For specific function info see 'IIOScheduler.hpp'
+class FIFOIOScheduler : public IIOScheduler {
+public:
+	virtual ~FIFOIOScheduler() = default;
+
+	void Add(const IORequest&) override;
+	bool PopNext(std::uint32_t headTrack, std::uint64_t now, IORequest& out) override;
+	bool Remove(const ProcessControlBlock*) override;
+
+	std::size_t GetSize() const override { return mQueue.size(); }
+	IOSchedulingPolicy GetPolicy() const override { return IOSchedulingPolicy::FIFO; }
+
+private:
+	std::deque<IORequest> mQueue;
+};
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef _IIOSCHEDULER_HPP
+#define _IIOSCHEDULER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include "../util.hpp"
+
+struct ProcessControlBlock;
+
+enum class IOSchedulingPolicy : std::uint32_t {
+	FIFO = 0, // Requests are serviced in the order they arrive
+	SCAN,     // Elevator, the head sweeps across the tracks serving whatever it passes, then turns around
+	Deadline, // One way sweeps, but a request that has waited too long jumps the queue
+};
+
+// A single I/O burst waiting on (or being serviced by) a device
+struct IORequest {
+	ProcessControlBlock* mPcb  = nullptr;
+	std::uint32_t mTrack       = 0; // Where on the device the data lives
+	std::uint32_t mLength      = 0; // How long the transfer itself takes (in ticks)
+	std::uint64_t mSubmitTime  = 0; // When the request reached the device
+	std::uint64_t mDeadline    = 0; // When the request is considered starved (Deadline only)
+	std::uint64_t mSequence    = 0; // Arrival order, breaks ties between requests on the same track
+	bool mIsAsync              = false;
+};
+
+// Decides which queued request a device services next
+struct IIOScheduler {
+	virtual ~IIOScheduler() = default;
+
+	virtual void Add(const IORequest&) = 0;
+
+	// Selects and pops the next request to service given where the head is, false if nothing is queued
+	virtual bool PopNext(std::uint32_t headTrack, std::uint64_t now, IORequest& out) = 0;
+
+	// Drops a queued request for a process, false if it didn't have one queued
+	virtual bool Remove(const ProcessControlBlock*) = 0;
+
+	virtual std::size_t GetSize() const = 0;
+
+	// Gets the policy 'this' scheduler implements
+	virtual IOSchedulingPolicy GetPolicy() const = 0;
+};
+
+constexpr const char* IOPolicyToString(IOSchedulingPolicy policy)
+{
+	switch (policy) {
+	case IOSchedulingPolicy::FIFO:
+		return "FIFO";
+	case IOSchedulingPolicy::SCAN:
+		return "SCAN";
+	case IOSchedulingPolicy::Deadline:
+		return "DEADLINE";
+	default:
+		PanicExit("UNKNOWN I/O SCHEDULING POLICY");
+	}
+}
+
+#endif
@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <iomanip>
+
+#include "IODevice.hpp"
+
+IODevice::IODevice(std::string name, std::uint32_t queueDepth, std::unique_ptr<IIOScheduler> scheduler)
+    : mName(std::move(name))
+    , mQueueDepth(std::max<std::uint32_t>(queueDepth, 1))
+    , mScheduler(std::move(scheduler))
+{
+	REQUIRE(mScheduler != nullptr);
+}
+
+void IODevice::Submit(IORequest request, std::uint64_t now)
+{
+	request.mSubmitTime = now;
+	request.mDeadline   = now + DeadlineExpiry;
+	request.mSequence   = mNextSequence++;
+	mScheduler->Add(request);
+
+	mPeakQueueLength = std::max(mPeakQueueLength, mScheduler->GetSize());
+}
+
+bool IODevice::StartNext(std::uint64_t now, IORequest& out, std::uint32_t& serviceTime)
+{
+	if (mInFlight >= mQueueDepth || !mScheduler->PopNext(mHeadTrack, now, out)) {
+		return false;
+	}
+
+	// Move the head over, a full stroke costing 'gIoSeekCost'
+	const std::uint32_t distance = out.mTrack > mHeadTrack ? out.mTrack - mHeadTrack : mHeadTrack - out.mTrack;
+	const std::uint32_t seek     = static_cast<std::uint32_t>(static_cast<std::uint64_t>(distance) * cfg::gIoSeekCost / TrackCount);
+	mHeadTrack                   = out.mTrack;
+
+	serviceTime = seek + out.mLength;
+	mInFlight++;
+
+	const std::uint64_t waited = now - out.mSubmitTime;
+	mServiced++;
+	mTotalWait += waited;
+	mMaxWait = std::max(mMaxWait, waited);
+	mTotalSeek += seek;
+	mBusyTime += serviceTime;
+	return true;
+}
+
+void IODevice::Finish()
+{
+	REQUIRE(mInFlight > 0);
+	mInFlight--;
+}
+
+bool IODevice::Cancel(const ProcessControlBlock* pcb) { return mScheduler->Remove(pcb); }
+
+void IODevice::PrintStats(std::uint64_t elapsed) const
+{
+	if (!mServiced) {
+		return;
+	}
+
+	// Busy time is spread over every slot the device has, so overlapping requests still top out at 100%
+	const double utilisation = elapsed ? 100.0 * static_cast<double>(mBusyTime) / static_cast<double>(elapsed * mQueueDepth) : 0.0;
+	ThreadPrint("DEVICE [", mName, "] (", IOPolicyToString(mScheduler->GetPolicy()), ", DEPTH ", mQueueDepth, ") SERVICED [", mServiced,
+	            "] QUEUE WAIT AVG [", mTotalWait / mServiced, " ticks] MAX [", mMaxWait, " ticks] SEEK AVG [", mTotalSeek / mServiced,
+	            " ticks] PEAK QUEUE [", mPeakQueueLength, "] UTILISATION [", std::fixed, std::setprecision(2), utilisation, "%]");
+}
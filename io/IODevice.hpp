@@ -0,0 +1,60 @@
+#ifndef _IODEVICE_HPP
+#define _IODEVICE_HPP
+
+#include <memory>
+#include <string>
+
+#include "IIOScheduler.hpp"
+#include "../util.hpp"
+
+// A simulated I/O device, servicing at most 'queueDepth' requests at once and queueing the rest
+// Service time is the transfer length plus a seek proportional to how far the head has to travel
+// NOTE: not thread safe, the InterruptController serialises access
+class IODevice {
+public:
+	NON_COPYABLE(IODevice)
+
+	static constexpr std::uint32_t TrackCount     = 1000;
+	static constexpr std::uint64_t DeadlineExpiry = 500; // How long a request can queue before Deadline serves it first (in ticks)
+
+	IODevice(std::string name, std::uint32_t queueDepth, std::unique_ptr<IIOScheduler> scheduler);
+	~IODevice() = default;
+
+	// Queues a request, call StartNext() afterwards to see if it can be serviced straight away
+	void Submit(IORequest request, std::uint64_t now);
+
+	// Moves the next request into service if the device has room, 'serviceTime' being how long it'll take
+	bool StartNext(std::uint64_t now, IORequest& out, std::uint32_t& serviceTime);
+
+	// A request has left service (completed or aborted), freeing up its slot
+	void Finish();
+
+	// Drops a queued request for a process, false if it wasn't queued (e.g. it's already being serviced)
+	bool Cancel(const ProcessControlBlock*);
+
+	void PrintStats(std::uint64_t elapsed) const;
+
+	inline const std::string& GetName() const { return mName; }
+	inline std::size_t GetQueueLength() const { return mScheduler->GetSize(); }
+	inline std::uint32_t GetInFlight() const { return mInFlight; }
+
+private:
+	std::string mName;
+	std::uint32_t mQueueDepth = 1;
+	std::unique_ptr<IIOScheduler> mScheduler;
+
+	// State
+	std::uint32_t mHeadTrack    = 0;
+	std::uint32_t mInFlight     = 0;
+	std::uint64_t mNextSequence = 0;
+
+	// Statistics (in ticks)
+	std::uint64_t mServiced      = 0;
+	std::uint64_t mTotalWait     = 0; // Time spent queued before service started
+	std::uint64_t mMaxWait       = 0;
+	std::uint64_t mTotalSeek     = 0;
+	std::uint64_t mBusyTime      = 0; // Sum of service times
+	std::size_t mPeakQueueLength = 0;
+};
+
+#endif
@@ -0,0 +1,38 @@
+#include <algorithm>
+
+#include "SCANIOScheduler.hpp"
+
+void SCANIOScheduler::Add(const IORequest& request) { mQueue.emplace(std::make_pair(request.mTrack, request.mSequence), request); }
+
+bool SCANIOScheduler::PopNext(std::uint32_t headTrack, std::uint64_t, IORequest& out)
+{
+	if (mQueue.empty()) {
+		return false;
+	}
+
+	// Carry on in the current direction, turning around if there's nothing left that way
+	auto it = mQueue.end();
+	if (mIsAscending) {
+		it = mQueue.lower_bound({ headTrack, 0 });
+		if (it == mQueue.end()) {
+			mIsAscending = false;
+			it           = std::prev(mQueue.end());
+		}
+	} else {
+		it = mQueue.upper_bound({ headTrack, ~0ull });
+		if (it == mQueue.begin()) {
+			mIsAscending = true;
+		} else {
+			--it;
+		}
+	}
+
+	out = it->second;
+	mQueue.erase(it);
+	return true;
+}
+
+bool SCANIOScheduler::Remove(const ProcessControlBlock* pcb)
+{
+	return std::erase_if(mQueue, [pcb](const auto& entry) { return entry.second.mPcb == pcb; }) != 0;
+}
@@ -0,0 +1,27 @@
+#ifndef _SCANIOSCHEDULER_HPP
+#define _SCANIOSCHEDULER_HPP
+
+#include <utility>
+#include <map>
+
+#include "IIOScheduler.hpp"
+
+// For specific function info see 'IIOScheduler.hpp'
+class SCANIOScheduler : public IIOScheduler {
+public:
+	virtual ~SCANIOScheduler() = default;
+
+	void Add(const IORequest&) override;
+	bool PopNext(std::uint32_t headTrack, std::uint64_t now, IORequest& out) override;
+	bool Remove(const ProcessControlBlock*) override;
+
+	std::size_t GetSize() const override { return mQueue.size(); }
+	IOSchedulingPolicy GetPolicy() const override { return IOSchedulingPolicy::SCAN; }
+
+private:
+	// Ordered by track, then arrival
+	std::map<std::pair<std::uint32_t, std::uint64_t>, IORequest> mQueue;
+	bool mIsAscending = true; // Which way the head is sweeping
+};
+
+#endif
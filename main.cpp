@@ -9,8 +9,8 @@
 #include <cctype>
 #include <thread>
 #include <array>
+#include <vector>
 #include <mutex>
-#include <list>
 #include <map>
 
 #include "Process.hpp"
@@ -23,6 +23,10 @@
 #include "algo/FCFSScheduler.hpp"
 #include "algo/SJFScheduler.hpp"
 #include "algo/RRScheduler.hpp"
+#include "algo/MLFQScheduler.hpp"
+#include "algo/FairScheduler.hpp"
+#include "algo/EDFScheduler.hpp"
+#include "algo/GroupScheduler.hpp"
 
 // Allow custom colours to work in Windows
 #ifdef _WIN32
@@ -58,7 +62,35 @@ namespace cfg {
 	std::uint32_t gProcessBurstMinimum    = 5;
 	std::uint32_t gProcessBurstMaximum    = 25;
 	std::uint32_t gInitialBurstPrediction = 1000;
+	std::uint32_t gBurstPredictor         = 0;
 	std::uint32_t gRoundRobinTimeQuantum  = 2500;
+	std::uint32_t gRoundRobinPercentile   = 0;
+	std::uint32_t gMlfqLevelCount         = 4;
+	std::uint32_t gMlfqBaseQuantum        = 500;
+	std::uint32_t gMlfqBoostPeriod        = 20000;
+	std::uint32_t gFairTargetLatency      = 20000;
+	std::uint32_t gFairMinGranularity     = 2500;
+	std::uint32_t gEdfAdmission           = 1;
+	bool gVirtualTime                     = false;
+	bool gFastForward                     = true;
+	std::uint32_t gIrqCoalesceCount       = 1;
+	std::uint32_t gIrqCoalesceWindow      = 100;
+	std::uint32_t gInterruptCost          = 0;
+	std::uint32_t gIoDeviceCount          = 0;
+	std::uint32_t gIoQueueDepth           = 1;
+	std::uint32_t gIoScheduler            = 0;
+	std::uint32_t gIoSeekCost             = 500;
+	std::uint32_t gAsyncIoChance          = 0;
+	std::uint32_t gDeadlineSlack          = 600;
+	std::uint32_t gGroupPeriod            = 10000;
+	std::uint32_t gGroupSlice             = 2500;
+	std::uint32_t gSchedulerOverhead      = 0;
+	std::uint32_t gSchedulerCompareCost   = 2;
+	std::uint32_t gSchedulerMoveCost      = 4;
+	std::uint32_t gSchedulerLockCost      = 25;
+	std::uint32_t gSchedulerTickLength    = 1000000;
+	std::vector<std::uint32_t> gGroupShares;
+	std::vector<std::uint32_t> gGroupQuotas;
 } // namespace cfg
 
 namespace {
@@ -114,8 +146,135 @@ namespace {
 		std::int64_t procCount = static_cast<std::uint32_t>(GetNumber(5));
 
 		if (algo == SchedulingAlgorithm::RoundRobin) {
-			std::cout << "7. How long should the time quantum be? [default - " << cfg::gRoundRobinTimeQuantum << "] - ";
+			std::cout << "7a. How long should the time quantum be? [default - " << cfg::gRoundRobinTimeQuantum << "] - ";
 			cfg::gRoundRobinTimeQuantum = static_cast<std::uint32_t>(GetNumber(cfg::gRoundRobinTimeQuantum));
+
+			std::cout << "7b. Adapt the quantum so this percentage of CPU bursts fit in one? (0 - no, keep it fixed) [default - "
+			          << cfg::gRoundRobinPercentile << "] - ";
+			cfg::gRoundRobinPercentile = static_cast<std::uint32_t>(GetNumber(cfg::gRoundRobinPercentile));
+		}
+
+		if (algo == SchedulingAlgorithm::MLFQ) {
+			std::cout << "7a. How many queue levels should there be? [default - " << cfg::gMlfqLevelCount << "] - ";
+			cfg::gMlfqLevelCount = static_cast<std::uint32_t>(GetNumber(cfg::gMlfqLevelCount));
+
+			std::cout << "7b. How long should the top level's time quantum be? (doubles every level down) [default - " << cfg::gMlfqBaseQuantum
+			          << "] - ";
+			cfg::gMlfqBaseQuantum = static_cast<std::uint32_t>(GetNumber(cfg::gMlfqBaseQuantum));
+
+			std::cout << "7c. How often should everything be boosted back to the top level? (0 - never) [default - " << cfg::gMlfqBoostPeriod
+			          << "] - ";
+			cfg::gMlfqBoostPeriod = static_cast<std::uint32_t>(GetNumber(cfg::gMlfqBoostPeriod));
+		}
+
+		if (algo == SchedulingAlgorithm::Fair) {
+			std::cout << "7a. How long should it take to run every ready process once? (target latency) [default - "
+			          << cfg::gFairTargetLatency << "] - ";
+			cfg::gFairTargetLatency = static_cast<std::uint32_t>(GetNumber(cfg::gFairTargetLatency));
+
+			std::cout << "7b. What is the shortest slice a process can be given? (minimum granularity) [default - " << cfg::gFairMinGranularity
+			          << "] - ";
+			cfg::gFairMinGranularity = static_cast<std::uint32_t>(GetNumber(cfg::gFairMinGranularity));
+		}
+
+		if (algo == SchedulingAlgorithm::EDF) {
+			std::cout << "7. What happens to processes that would make deadlines unmeetable? (0 - admit, 1 - defer, 2 - reject) [default - "
+			          << cfg::gEdfAdmission << "] - ";
+			cfg::gEdfAdmission = static_cast<std::uint32_t>(GetNumber(cfg::gEdfAdmission));
+		}
+
+		if (algo == SchedulingAlgorithm::SJF || algo == SchedulingAlgorithm::SRTF) {
+			std::cout << "7. How should burst lengths be predicted? (0 - EWMA, 1 - Adaptive EWMA, 2 - Median, 3 - Oracle) [default - "
+			          << cfg::gBurstPredictor << "] - ";
+			cfg::gBurstPredictor = static_cast<std::uint32_t>(GetNumber(cfg::gBurstPredictor));
+		}
+
+		std::cout << std::endl;
+		std::cout << "The following options control the simulation itself:" << std::endl;
+
+		std::cout << "8. Run in virtual time, skipping all real waiting? (0 - no, 1 - yes) [default - " << cfg::gVirtualTime << "] - ";
+		cfg::gVirtualTime = GetNumber(cfg::gVirtualTime) != 0;
+
+		if (cfg::gVirtualTime) {
+			std::cout << "9. Fast-forward over ticks where nothing happens? (0 - no, 1 - yes) [default - " << cfg::gFastForward << "] - ";
+			cfg::gFastForward = GetNumber(cfg::gFastForward) != 0;
+		}
+
+		std::cout << "10. How many I/O completions can be coalesced into one interrupt? (1 - off) [default - " << cfg::gIrqCoalesceCount
+		          << "] - ";
+		cfg::gIrqCoalesceCount = static_cast<std::uint32_t>(GetNumber(cfg::gIrqCoalesceCount));
+
+		if (cfg::gIrqCoalesceCount > 1) {
+			std::cout << "11. How long can a completion wait to be coalesced? [default - " << cfg::gIrqCoalesceWindow << "] - ";
+			cfg::gIrqCoalesceWindow = static_cast<std::uint32_t>(GetNumber(cfg::gIrqCoalesceWindow));
+		}
+
+		std::cout << "12. What is the cost of handling an interrupt? [default - " << cfg::gInterruptCost << "] - ";
+		cfg::gInterruptCost = static_cast<std::uint32_t>(GetNumber(cfg::gInterruptCost));
+
+		std::cout << "13. How many I/O devices should bursts queue on? (0 - ideal, no queueing) [default - " << cfg::gIoDeviceCount << "] - ";
+		cfg::gIoDeviceCount = static_cast<std::uint32_t>(GetNumber(cfg::gIoDeviceCount));
+
+		if (cfg::gIoDeviceCount) {
+			std::cout << "14. How many requests can a device service at once? [default - " << cfg::gIoQueueDepth << "] - ";
+			cfg::gIoQueueDepth = static_cast<std::uint32_t>(GetNumber(cfg::gIoQueueDepth));
+
+			std::cout << "15. How should devices order their queue? (0 - FIFO, 1 - SCAN, 2 - Deadline) [default - " << cfg::gIoScheduler
+			          << "] - ";
+			cfg::gIoScheduler = static_cast<std::uint32_t>(GetNumber(cfg::gIoScheduler));
+
+			std::cout << "16. How long does a seek across the whole device take? [default - " << cfg::gIoSeekCost << "] - ";
+			cfg::gIoSeekCost = static_cast<std::uint32_t>(GetNumber(cfg::gIoSeekCost));
+		}
+
+		std::cout << "17. What percentage of I/O bursts should be asynchronous? [default - " << cfg::gAsyncIoChance << "] - ";
+		cfg::gAsyncIoChance = std::min<std::uint32_t>(static_cast<std::uint32_t>(GetNumber(cfg::gAsyncIoChance)), 100);
+
+		std::cout << "18. How late can a CPU burst's deadline be, at most? (% of its length, at least " << Process::MinimumDeadlineSlack
+		          << ") [default - " << cfg::gDeadlineSlack << "] - ";
+		cfg::gDeadlineSlack = static_cast<std::uint32_t>(GetNumber(cfg::gDeadlineSlack));
+
+		std::cout << "19. How many groups should processes be split between? (0 - no groups) [default - 0] - ";
+		const std::size_t groupCount = std::min<std::size_t>(static_cast<std::size_t>(std::max<std::int64_t>(GetNumber(0), 0)),
+		                                                     GroupScheduler::MaxGroups);
+
+		if (groupCount) {
+			std::cout << "19a. How long is a quota period? [default - " << cfg::gGroupPeriod << "] - ";
+			cfg::gGroupPeriod = static_cast<std::uint32_t>(GetNumber(cfg::gGroupPeriod));
+
+			std::cout << "19b. How long does a group keep the CPU before one that's behind can take over? [default - " << cfg::gGroupSlice
+			          << "] - ";
+			cfg::gGroupSlice = static_cast<std::uint32_t>(GetNumber(cfg::gGroupSlice));
+
+			for (std::size_t i = 0; i < groupCount; ++i) {
+				std::cout << "19c. What is group [" << i << "]'s share weight? [default - 1] - ";
+				cfg::gGroupShares.push_back(static_cast<std::uint32_t>(GetNumber(1)));
+
+				std::cout << "19d. What percentage of each period can group [" << i << "] use? (0 - uncapped) [default - 0] - ";
+				cfg::gGroupQuotas.push_back(static_cast<std::uint32_t>(GetNumber(0)));
+			}
+		}
+
+		std::cout << "20. Charge the scheduler's own work as simulated time? (0 - no, 1 - cost table, 2 - measured) [default - "
+		          << cfg::gSchedulerOverhead << "] - ";
+		cfg::gSchedulerOverhead = std::min<std::uint32_t>(static_cast<std::uint32_t>(GetNumber(cfg::gSchedulerOverhead)),
+		                                                  static_cast<std::uint32_t>(SchedulerOverhead::Measured));
+
+		if (cfg::gSchedulerOverhead == static_cast<std::uint32_t>(SchedulerOverhead::CostTable)) {
+			std::cout << "20a. What does a comparison cost? (in ns) [default - " << cfg::gSchedulerCompareCost << "] - ";
+			cfg::gSchedulerCompareCost = static_cast<std::uint32_t>(GetNumber(cfg::gSchedulerCompareCost));
+
+			std::cout << "20b. What does moving a process in a queue cost? (in ns) [default - " << cfg::gSchedulerMoveCost << "] - ";
+			cfg::gSchedulerMoveCost = static_cast<std::uint32_t>(GetNumber(cfg::gSchedulerMoveCost));
+
+			std::cout << "20c. What does taking the run queue lock cost? (in ns) [default - " << cfg::gSchedulerLockCost << "] - ";
+			cfg::gSchedulerLockCost = static_cast<std::uint32_t>(GetNumber(cfg::gSchedulerLockCost));
+		}
+
+		if (cfg::gSchedulerOverhead) {
+			std::cout << "20d. How many ns of scheduler work make up a tick? (lower exaggerates it) [default - " << cfg::gSchedulerTickLength
+			          << "] - ";
+			cfg::gSchedulerTickLength = std::max<std::uint32_t>(static_cast<std::uint32_t>(GetNumber(cfg::gSchedulerTickLength)), 1);
 		}
 
 		std::cout << "[/SETTINGS]" << std::endl << std::endl;
@@ -123,25 +282,44 @@ namespace {
 		return procCount;
 	}
 
-	static const std::map<SchedulingAlgorithm, std::function<std::unique_ptr<IScheduler>()>> SchedulerFactoryMap {
-		{ SchedulingAlgorithm::FCFS, [] { return std::make_unique<FCFSScheduler>(); } },
-		{ SchedulingAlgorithm::SJF, [] { return std::make_unique<SJFScheduler>(); } },
-		{ SchedulingAlgorithm::SRTF, [] { return std::make_unique<SRTFScheduler>(); } },
-		{ SchedulingAlgorithm::RoundRobin, [] { return std::make_unique<RRScheduler>(); } },
-		{ SchedulingAlgorithm::Priority, [] { return std::make_unique<PriorityScheduler>(); } },
+	// Makes the scheduler, along with the CPU loops compiled for it on its own and inside groups (see 'CpuPolicy.hpp')
+	struct SchedulerFactory {
+		std::function<std::unique_ptr<IScheduler>()> mMake;
+		CPU::TickLoop mTickLoop;
+		CPU::TickLoop mGroupedTickLoop;
+	};
+
+	template <SchedulingAlgorithm Algo, typename Scheduler>
+	SchedulerFactory MakeFactory()
+	{
+		return { [] { return std::make_unique<Scheduler>(); }, CPU::GetTickLoop<StaticPolicy<Algo, Scheduler>>(),
+		         CPU::GetTickLoop<StaticPolicy<Algo, GroupScheduler>>() };
+	}
+
+	static const std::map<SchedulingAlgorithm, SchedulerFactory> SchedulerFactoryMap {
+		{ SchedulingAlgorithm::FCFS, MakeFactory<SchedulingAlgorithm::FCFS, FCFSScheduler>() },
+		{ SchedulingAlgorithm::SJF, MakeFactory<SchedulingAlgorithm::SJF, SJFScheduler>() },
+		{ SchedulingAlgorithm::SRTF, MakeFactory<SchedulingAlgorithm::SRTF, SRTFScheduler>() },
+		{ SchedulingAlgorithm::RoundRobin, MakeFactory<SchedulingAlgorithm::RoundRobin, RRScheduler>() },
+		{ SchedulingAlgorithm::Priority, MakeFactory<SchedulingAlgorithm::Priority, PriorityScheduler>() },
+		{ SchedulingAlgorithm::MLFQ, MakeFactory<SchedulingAlgorithm::MLFQ, MLFQScheduler>() },
+		{ SchedulingAlgorithm::Fair, MakeFactory<SchedulingAlgorithm::Fair, FairScheduler>() },
+		{ SchedulingAlgorithm::EDF, MakeFactory<SchedulingAlgorithm::EDF, EDFScheduler>() },
 	};
 
-	std::unique_ptr<IScheduler> MakeScheduler(SchedulingAlgorithm algo)
+	const SchedulerFactory& GetSchedulerFactory(SchedulingAlgorithm algo)
 	{
-		// Search and run the factory function, if found
+		// Search for the factory, if found
 		if (auto it = SchedulerFactoryMap.find(algo); it != SchedulerFactoryMap.end()) {
-			return it->second();
+			return it->second;
 		}
 
 		PanicExit("UNKNOWN SCHEDULING ALGORITHM SUPPLIED");
 	}
 
-	constexpr std::array<std::pair<std::string_view, std::string_view>, 6> AlgorithmProsCons {
+	std::unique_ptr<IScheduler> MakeScheduler(SchedulingAlgorithm algo) { return GetSchedulerFactory(algo).mMake(); }
+
+	constexpr std::array<std::pair<std::string_view, std::string_view>, 8> AlgorithmProsCons {
 		{ // FCFS
 		  { "Simple to implement; minimal scheduler overhead", "Can suffer convoy effect; poor average waiting time" },
 		  // SJF
@@ -153,7 +331,16 @@ namespace {
 		    "Quantum too small -> high overhead; too large -> degenerates to FCFS" },
 		  // Priority
 		  { "Controls task importance directly; flexible policy",
-		    "Low-priority starvation; priority inversion without extra handling" } }
+		    "Low-priority starvation; priority inversion without extra handling" },
+		  // MLFQ
+		  { "Favours interactive / I/O-bound work without knowing burst lengths; O(1) pick",
+		    "Many knobs to tune (levels, quanta, boost period); CPU-bound jobs wait between boosts" },
+		  // Fair
+		  { "CPU shared in proportion to priority; fast wakeups without a fixed quantum",
+		    "O(log n) queue operations; no notion of deadlines or burst lengths" },
+		  // EDF
+		  { "Optimal for deadlines on one CPU; admission control keeps the task set schedulable",
+		    "Collapses unpredictably once overloaded; needs every burst's deadline up front" } }
 	};
 
 	static const std::map<SchedulingAlgorithm, std::string_view> AlgorithmNameMap {
@@ -162,6 +349,9 @@ namespace {
 		{ SchedulingAlgorithm::SRTF, "SRTF - Shortest Remaining Time First" },
 		{ SchedulingAlgorithm::RoundRobin, "Round Robin" },
 		{ SchedulingAlgorithm::Priority, "Priority" },
+		{ SchedulingAlgorithm::MLFQ, "MLFQ - Multi-Level Feedback Queue" },
+		{ SchedulingAlgorithm::Fair, "Fair - Completely Fair (CFS-style)" },
+		{ SchedulingAlgorithm::EDF, "EDF - Earliest Deadline First" },
 	};
 
 	inline SchedulingAlgorithm GetAlgorithm()
@@ -193,7 +383,6 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
 #endif
 
 	SchedulingAlgorithm algo = GetAlgorithm();
-	CPU cpu(MakeScheduler(algo));
 
 	// [FACT CHECK] independent reviewers have deemed this: TRUE
 	{
@@ -203,18 +392,36 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
 
 		auto& [pros, cons] = AlgorithmProsCons[static_cast<std::size_t>(algo)];
 		std::cout << "Pros - " << pros << std::endl << "Cons - " << cons << std::endl;
-		std::cout << "Is preemption enabled for this algorithm? " << "[" << (cpu.IsPreemptionAllowed() ? "YES" : "NO") << "]" << std::endl
+		std::cout << "Is preemption enabled for this algorithm? " << "[" << (CPU::IsPreemptionAllowed(algo) ? "YES" : "NO") << "]"
+		          << std::endl
 		          << std::endl;
 	}
 
-	// Dynamically create all processes based on the users input
+	// The scheduler depends on the settings (e.g. whether processes are grouped), so the CPU is only built once they're known
 	std::size_t processes = static_cast<std::size_t>(GetProcesses(algo));
-	std::list<ProcessControlBlock> pcbs;
+
+	// The CPU runs the tick loop compiled for exactly this scheduler
+	const SchedulerFactory& factory       = GetSchedulerFactory(algo);
+	std::unique_ptr<IScheduler> scheduler = factory.mMake();
+	CPU::TickLoop tickLoop                = factory.mTickLoop;
+	if (!cfg::gGroupShares.empty()) {
+		scheduler = std::make_unique<GroupScheduler>([algo] { return MakeScheduler(algo); });
+		tickLoop  = factory.mGroupedTickLoop;
+	}
+
+	CPU cpu(std::move(scheduler));
+	cpu.SetTickLoop(tickLoop);
+
+	// Dynamically create all processes based on the users input, dealt out between the groups in turn
+	std::vector<ProcessControlBlock*> created(processes);
 	for (std::size_t i = 0; i < processes; ++i) {
-		pcbs.emplace_back(&cpu);
-		cpu.AddProcess(&pcbs.back());
+		created[i]         = cpu.GetArena().Create<ProcessControlBlock>(&cpu);
+		created[i]->mGroup = static_cast<std::uint32_t>(cfg::gGroupShares.empty() ? 0 : i % cfg::gGroupShares.size());
 	}
 
+	// ... and handed to the scheduler in one go
+	cpu.AddProcessBatch(created);
+
 	cpu.Run();
 
 	return EXIT_SUCCESS;
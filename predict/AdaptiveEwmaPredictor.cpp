@@ -0,0 +1,22 @@
+#include <algorithm>
+#include <cmath>
+
+#include "AdaptiveEwmaPredictor.hpp"
+
+AdaptiveEwmaPredictor::AdaptiveEwmaPredictor()
+    : mEstimate(static_cast<float_t>(cfg::gInitialBurstPrediction))
+{
+}
+
+void AdaptiveEwmaPredictor::OnBurstComplete(float_t actual)
+{
+	const float_t error = actual - mEstimate;
+	mSmoothedError      = Smoothing * error + (1.0f - Smoothing) * mSmoothedError;
+	mSmoothedAbsError   = Smoothing * std::fabs(error) + (1.0f - Smoothing) * mSmoothedAbsError;
+
+	if (mSmoothedAbsError > 0.0f) {
+		mAlpha = std::clamp(std::fabs(mSmoothedError) / mSmoothedAbsError, MinAlpha, 1.0f);
+	}
+
+	mEstimate = mAlpha * actual + (1.0f - mAlpha) * mEstimate;
+}
@@ -0,0 +1,29 @@
+#ifndef _ADAPTIVEEWMAPREDICTOR_HPP
+#define _ADAPTIVEEWMAPREDICTOR_HPP
+
+#include "IBurstPredictor.hpp"
+
+// For specific function info see 'IBurstPredictor.hpp'
+// Trigg & Leach style adaptive smoothing, alpha is the ratio of the smoothed error to the smoothed absolute error:
+// errors that keep pointing the same way (the process has changed behaviour) push it towards 1, noise pulls it towards 0
+class AdaptiveEwmaPredictor : public IBurstPredictor {
+public:
+	static constexpr float_t Smoothing = 0.2f; // How quickly the error tracking itself reacts
+	static constexpr float_t MinAlpha  = 0.05f;
+
+	AdaptiveEwmaPredictor();
+	virtual ~AdaptiveEwmaPredictor() = default;
+
+	float_t Predict(const ProcessWork&) const override { return mEstimate; }
+	void OnBurstComplete(float_t actual) override;
+
+	BurstPredictorType GetType() const override { return BurstPredictorType::AdaptiveEWMA; }
+
+private:
+	float_t mEstimate         = 0.0f;
+	float_t mAlpha            = 0.5f;
+	float_t mSmoothedError    = 0.0f;
+	float_t mSmoothedAbsError = 0.0f;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#include <cmath>
+
+#include "IBurstPredictor.hpp"
+#include "EwmaPredictor.hpp"
+#include "AdaptiveEwmaPredictor.hpp"
+#include "MedianPredictor.hpp"
+#include "OraclePredictor.hpp"
+
+std::unique_ptr<IBurstPredictor> MakeBurstPredictor(BurstPredictorType type)
+{
+	switch (type) {
+	case BurstPredictorType::EWMA:
+		return std::make_unique<EwmaPredictor>();
+	case BurstPredictorType::AdaptiveEWMA:
+		return std::make_unique<AdaptiveEwmaPredictor>();
+	case BurstPredictorType::Median:
+		return std::make_unique<MedianPredictor>();
+	case BurstPredictorType::Oracle:
+		return std::make_unique<OraclePredictor>();
+	}
+
+	PanicExit("UNKNOWN BURST PREDICTOR SUPPLIED");
+}
+
+void BurstPredictionStats::Record(float_t predicted, float_t actual)
+{
+	const double error = static_cast<double>(predicted) - static_cast<double>(actual);
+
+	mBursts++;
+	mTotalAbsoluteError += std::fabs(error);
+	mTotalSignedError += error;
+	mTotalRelativeError += actual > 0.0f ? std::fabs(error) / static_cast<double>(actual) : 0.0;
+}
+
+void BurstPredictionStats::Print(BurstPredictorType type) const
+{
+	if (!mBursts) {
+		return;
+	}
+
+	const double count = static_cast<double>(mBursts);
+	ThreadPrint("BURST PREDICTION (", PredictorTypeToString(type), ") OVER [", mBursts, "] BURSTS - MEAN ERROR [", std::fixed,
+	            std::setprecision(2), mTotalAbsoluteError / count, " ticks] BIAS [", mTotalSignedError / count, " ticks] MAPE [",
+	            100.0 * mTotalRelativeError / count, "%]\r\n");
+}
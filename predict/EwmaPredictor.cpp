@@ -0,0 +1,12 @@
+#include "EwmaPredictor.hpp"
+
+EwmaPredictor::EwmaPredictor()
+    : mEstimate(static_cast<float_t>(cfg::gInitialBurstPrediction))
+{
+}
+
+void EwmaPredictor::OnBurstComplete(float_t actual)
+{
+	// tau_next = alpha * t_n + (1 - alpha) * tau_n
+	mEstimate = Alpha * actual + (1.0f - Alpha) * mEstimate;
+}
@@ -0,0 +1,23 @@
+#ifndef _EWMAPREDICTOR_HPP
+#define _EWMAPREDICTOR_HPP
+
+#include "IBurstPredictor.hpp"
+
+// For specific function info see 'IBurstPredictor.hpp'
+class EwmaPredictor : public IBurstPredictor {
+public:
+	static constexpr float_t Alpha = 0.5f; // [0 -> 1] 1 = recent bursts mean more
+
+	EwmaPredictor();
+	virtual ~EwmaPredictor() = default;
+
+	float_t Predict(const ProcessWork&) const override { return mEstimate; }
+	void OnBurstComplete(float_t actual) override;
+
+	BurstPredictorType GetType() const override { return BurstPredictorType::EWMA; }
+
+private:
+	float_t mEstimate = 0.0f;
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef _IBURSTPREDICTOR_HPP
+#define _IBURSTPREDICTOR_HPP
+
+#include <cstdint>
+#include <memory>
+
+#include "../util.hpp"
+
+struct ProcessWork;
+
+enum class BurstPredictorType : std::uint32_t {
+	EWMA = 0,     // tau_next = alpha * t_n + (1 - alpha) * tau_n, with a fixed alpha
+	AdaptiveEWMA, // ... with alpha following how consistently the process has been mispredicted
+	Median,       // Median of the last few bursts, shrugs off the odd outlier
+	Oracle,       // Knows the real length, the best any predictor could ever do
+};
+
+// Guesses how long a process' next CPU burst is, every process gets its own instance to keep its history in
+struct IBurstPredictor {
+	virtual ~IBurstPredictor() = default;
+
+	// Predicted length of 'next' (the process' current front burst)
+	virtual float_t Predict(const ProcessWork& next) const = 0;
+
+	// A CPU burst ran to completion after 'actual' ticks
+	virtual void OnBurstComplete(float_t actual) = 0;
+
+	// Gets the type 'this' predictor implements
+	virtual BurstPredictorType GetType() const = 0;
+};
+
+std::unique_ptr<IBurstPredictor> MakeBurstPredictor(BurstPredictorType type);
+
+constexpr const char* PredictorTypeToString(BurstPredictorType type)
+{
+	switch (type) {
+	case BurstPredictorType::EWMA:
+		return "EWMA";
+	case BurstPredictorType::AdaptiveEWMA:
+		return "ADAPTIVE EWMA";
+	case BurstPredictorType::Median:
+		return "MEDIAN";
+	case BurstPredictorType::Oracle:
+		return "ORACLE";
+	default:
+		PanicExit("UNKNOWN BURST PREDICTOR");
+	}
+}
+
+// How far off the predictions were over a run, fed every time a CPU burst completes
+struct BurstPredictionStats {
+	void Record(float_t predicted, float_t actual);
+	void Print(BurstPredictorType type) const;
+
+	std::uint64_t mBursts      = 0;
+	double mTotalAbsoluteError = 0.0;
+	double mTotalSignedError   = 0.0; // Positive = over-predicting
+	double mTotalRelativeError = 0.0;
+};
+
+#endif
@@ -0,0 +1,32 @@
+#include <algorithm>
+
+#include "MedianPredictor.hpp"
+
+float_t MedianPredictor::Predict(const ProcessWork&) const
+{
+	// Nothing to go on yet
+	if (!mCount) {
+		return static_cast<float_t>(cfg::gInitialBurstPrediction);
+	}
+
+	// Insertion sort, it's at most five elements (std::sort trips GCC's -Warray-bounds on the fixed-size window)
+	std::array<float_t, WindowSize> sorted = mWindow;
+	for (std::size_t i = 1; i < mCount; ++i) {
+		const float_t value = sorted[i];
+		std::size_t j       = i;
+		for (; j > 0 && sorted[j - 1] > value; --j) {
+			sorted[j] = sorted[j - 1];
+		}
+		sorted[j] = value;
+	}
+
+	const std::size_t middle = mCount / 2;
+	return mCount % 2 ? sorted[middle] : 0.5f * (sorted[middle - 1] + sorted[middle]);
+}
+
+void MedianPredictor::OnBurstComplete(float_t actual)
+{
+	mWindow[mHead] = actual;
+	mHead          = (mHead + 1) % WindowSize;
+	mCount         = std::min(mCount + 1, WindowSize);
+}
@@ -0,0 +1,26 @@
+#ifndef _MEDIANPREDICTOR_HPP
+#define _MEDIANPREDICTOR_HPP
+
+#include <array>
+
+#include "IBurstPredictor.hpp"
+
+// For specific function info see 'IBurstPredictor.hpp'
+class MedianPredictor : public IBurstPredictor {
+public:
+	static constexpr std::size_t WindowSize = 5;
+
+	virtual ~MedianPredictor() = default;
+
+	float_t Predict(const ProcessWork&) const override;
+	void OnBurstComplete(float_t actual) override;
+
+	BurstPredictorType GetType() const override { return BurstPredictorType::Median; }
+
+private:
+	std::array<float_t, WindowSize> mWindow {}; // Ring buffer of the last bursts
+	std::size_t mHead  = 0;
+	std::size_t mCount = 0;
+};
+
+#endif
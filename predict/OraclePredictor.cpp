@@ -0,0 +1,7 @@
+#include "OraclePredictor.hpp"
+#include "../Process.hpp"
+
+float_t OraclePredictor::Predict(const ProcessWork& next) const
+{
+	return next.mType == ProcessWork::Type::CPU ? static_cast<float_t>(next.mDuration) : 0.0f;
+}
@@ -0,0 +1,18 @@
+#ifndef _ORACLEPREDICTOR_HPP
+#define _ORACLEPREDICTOR_HPP
+
+#include "IBurstPredictor.hpp"
+
+// For specific function info see 'IBurstPredictor.hpp'
+// Cheats and reads the burst's real length, an upper bound on how well any predictor can do (real schedulers can't know this)
+class OraclePredictor : public IBurstPredictor {
+public:
+	virtual ~OraclePredictor() = default;
+
+	float_t Predict(const ProcessWork& next) const override;
+	void OnBurstComplete(float_t) override { }
+
+	BurstPredictorType GetType() const override { return BurstPredictorType::Oracle; }
+};
+
+#endif
@@ -10,6 +10,7 @@
 #include <thread>
 #include <mutex>
 #include <chrono>
+#include <vector>
 
 #include <float.h>
 #include <math.h>
@@ -33,9 +34,81 @@ namespace cfg {
 	// The initial predicted cost of a burst in a process (in ms)
 	extern std::uint32_t gInitialBurstPrediction;
 
+	// How are burst lengths predicted for SJF / SRTF? (see 'BurstPredictorType')
+	extern std::uint32_t gBurstPredictor;
+
 	// How long should processes be able to compute before being switched?
 	extern std::uint32_t gRoundRobinTimeQuantum;
 
+	// Should the quantum adapt so this percentage of recent CPU bursts fit in a single one? (0 = no, the quantum above is fixed)
+	extern std::uint32_t gRoundRobinPercentile;
+
+	// How many levels does the MLFQ have, and how long is the top level's quantum? (doubling on every level down)
+	extern std::uint32_t gMlfqLevelCount;
+	extern std::uint32_t gMlfqBaseQuantum;
+
+	// How often is everything in the MLFQ boosted back to the top level? (in ticks, 0 = never)
+	extern std::uint32_t gMlfqBoostPeriod;
+
+	// How long should it take the fair scheduler to run every ready process once, and how short can a slice get? (in ticks)
+	extern std::uint32_t gFairTargetLatency;
+	extern std::uint32_t gFairMinGranularity;
+
+	// What does EDF do with a process that would make the task set unschedulable? (0 = admit anyway, 1 = defer it, 2 = reject it)
+	extern std::uint32_t gEdfAdmission;
+
+	// Should time be simulated? (1 tick = 1 ms, sleeps & I/O become events instead of real waits)
+	extern bool gVirtualTime;
+
+	// Should the CPU jump straight over ticks where nothing can happen? (virtual time only)
+	extern bool gFastForward;
+
+	// Interrupt coalescing, up to this many I/O completions are delivered as one interrupt (1 = off)
+	extern std::uint32_t gIrqCoalesceCount;
+
+	// ... but none of them wait longer than this after completing (in ticks)
+	extern std::uint32_t gIrqCoalesceWindow;
+
+	// How long does it take the CPU to take an interrupt, regardless of how many completions it carries? (in ticks)
+	extern std::uint32_t gInterruptCost;
+
+	// How many I/O devices do bursts queue on? (0 = an ideal device servicing every burst at once, without queueing)
+	extern std::uint32_t gIoDeviceCount;
+
+	// How many requests can each device service at once?
+	extern std::uint32_t gIoQueueDepth;
+
+	// How does each device order its queue? (see 'IOSchedulingPolicy')
+	extern std::uint32_t gIoScheduler;
+
+	// How long does it take a device to seek across every track? (in ticks)
+	extern std::uint32_t gIoSeekCost;
+
+	// What percentage of I/O bursts are submitted asynchronously, the process only blocking at a later wait point?
+	extern std::uint32_t gAsyncIoChance;
+
+	// How long after its release can a CPU burst's deadline be, at most? (as a percentage of the burst length, see 'MinimumDeadlineSlack')
+	extern std::uint32_t gDeadlineSlack;
+
+	// Group fair-share, each group's share weight and the percentage of every period it may use (0 = uncapped), empty = no groups
+	extern std::vector<std::uint32_t> gGroupShares;
+	extern std::vector<std::uint32_t> gGroupQuotas;
+
+	// How long is a quota period, and how long does a group keep the CPU before one that's behind takes over? (in ticks)
+	extern std::uint32_t gGroupPeriod;
+	extern std::uint32_t gGroupSlice;
+
+	// How is the scheduler's own work charged as simulated time? (see 'SchedulerOverhead')
+	extern std::uint32_t gSchedulerOverhead;
+
+	// What does each comparison, move and lock cost in the cost table? (in nanoseconds)
+	extern std::uint32_t gSchedulerCompareCost;
+	extern std::uint32_t gSchedulerMoveCost;
+	extern std::uint32_t gSchedulerLockCost;
+
+	// How many nanoseconds of scheduler work make up a tick? (lower exaggerates the overhead)
+	extern std::uint32_t gSchedulerTickLength;
+
 } // namespace cfg
 
 namespace {